@@ -39,19 +39,34 @@ AndLogic::AndLogic(vargb::Curve::Curve * curve_a,
 
 }
 
-void AndLogic::childUpdated()
+AndLogic::AndLogic(vargb::Curve::Curve * curves[], uint8_t num)
+: Logic(curves, num)
+{
+
+}
+
+void AndLogic::combine(const IlluminationSettings * child_settings[],
+		IlluminationSettings * into) const
 {
 
 	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
 	{
-		current_settings.values[i] =
-				curves[0]->currentSettings()->values[i] &
-				curves[1]->currentSettings()->values[i];
+		into->values[i] = child_settings[0]->values[i];
+		for (uint8_t c=1; c<num_curves; c++)
+		{
+			into->values[i] &= child_settings[c]->values[i];
+		}
 
 	}
 
 
 }
+
+void AndLogic::describe(LogicInstruction * into) const
+{
+	into->opcode = LogicOpAnd;
+}
+
 } /* namespace Curve */
 } /* namespace vargb */
 
@@ -0,0 +1,92 @@
+/*
+
+ Arena.cpp -- bump allocation for curves and schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/Arena.h"
+
+#define arena_align(s)		(((s) + (VaRGB_ARENA_ALIGNMENT - 1)) & ~((size_t)(VaRGB_ARENA_ALIGNMENT - 1)))
+
+namespace vargb {
+
+Arena::Arena(void * buffer, size_t size) :
+		space((uint8_t*)buffer),
+		space_size(size),
+		used_size(0),
+		owns_space(false)
+{
+	// start on an aligned address, whatever we were handed
+	size_t misalignment = arena_align((size_t)space) - (size_t)space;
+	if (misalignment > space_size)
+	{
+		misalignment = space_size;
+	}
+	space += misalignment;
+	space_size -= misalignment;
+}
+
+Arena::Arena(size_t size) :
+		space(NULL),
+		space_size(0),
+		used_size(0),
+		owns_space(true)
+{
+	// malloc()ed space is aligned for anything
+	space = (uint8_t*) VaRGB_MALLOC(size);
+	if (space)
+	{
+		space_size = size;
+	}
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+Arena::~Arena()
+{
+	if (owns_space && space)
+	{
+		VaRGB_FREE(space);
+	}
+}
+#endif
+
+void * Arena::allocate(size_t size)
+{
+	size_t aligned_size = arena_align(size ? size : 1);
+	if (! space || aligned_size > (space_size - used_size))
+	{
+		return NULL;
+	}
+
+	void * allocated = &(space[used_size]);
+	used_size += aligned_size;
+
+	return allocated;
+}
+
+} /* namespace vargb */
+
+void * operator new(size_t size, vargb::Arena & arena) VaRGB_NOTHROW
+{
+	return arena.allocate(size);
+}
+
+void operator delete(void * ptr, vargb::Arena & arena) VaRGB_NOTHROW
+{
+	// nothing is released individually (see Arena::reset())
+}
@@ -0,0 +1,135 @@
+/*
+
+ Baked.cpp --  Baked (frame table) curve implementation, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+
+#include "includes/VaRGBConfig.h"
+
+
+#ifdef VaRGB_ENABLE_SCHEDULE_BAKING
+
+
+#include "includes/Curves/Baked.h"
+
+namespace vargb {
+namespace Curve {
+
+
+Baked::Baked(const VaRGBPackedColor * frames, VaRGBTimeValue num_frames) :
+		Curve(0, 0, 0, 0),
+		frame_table(NULL),
+		current_frame(0)
+{
+	setFrames(frames, num_frames);
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+Baked::~Baked() {
+}
+#endif
+
+void Baked::setFrames(const VaRGBPackedColor * frames, VaRGBTimeValue num_frames)
+{
+	frame_table = frames;
+	curve_target.transition_ticks = frames ? num_frames : 0;
+
+	// we "end up" at the last frame
+	VaRGBPackedColor last_frame = curve_target.transition_ticks ? frame_table[num_frames - 1] : 0;
+	curve_target.values[vargb_red_idx] = VaRGB_PACKEDCOLOR_RED(last_frame);
+	curve_target.values[vargb_green_idx] = VaRGB_PACKEDCOLOR_GREEN(last_frame);
+	curve_target.values[vargb_blue_idx] = VaRGB_PACKEDCOLOR_BLUE(last_frame);
+}
+
+VaRGBPackedColor Baked::frameAt(VaRGBTimeValue tick) const
+{
+	if (! curve_target.transition_ticks)
+	{
+		return 0;
+	}
+
+	// past the end, we hold the last frame
+	if (tick >= curve_target.transition_ticks)
+	{
+		tick = curve_target.transition_ticks - 1;
+	}
+
+	return frame_table[tick];
+}
+
+void Baked::setCurrentFrame(VaRGBPackedColor frame)
+{
+	current_frame = frame;
+	current_settings.values[vargb_red_idx] = VaRGB_PACKEDCOLOR_RED(frame);
+	current_settings.values[vargb_green_idx] = VaRGB_PACKEDCOLOR_GREEN(frame);
+	current_settings.values[vargb_blue_idx] = VaRGB_PACKEDCOLOR_BLUE(frame);
+}
+
+void Baked::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
+{
+	// frames are absolute: initial settings play no part
+	tick_count = setTo;
+	setCurrentFrame(frameAt(tick_count));
+	settings_req_update = true;
+}
+
+void Baked::tick(VaRGBTimeValue num)
+{
+	tick_count += num;
+
+	VaRGBPackedColor frame = frameAt(tick_count);
+	if (frame != current_frame)
+	{
+		setCurrentFrame(frame);
+		settings_req_update = true;
+	}
+
+	if (tick_count >= curve_target.transition_ticks)
+	{
+		curve_completed = true;
+	}
+}
+
+VaRGBTimeValue Baked::ticksUntilNextChange()
+{
+	// look ahead for the next frame that differs
+	VaRGBTimeValue next_tick = tick_count + 1;
+	while (next_tick < curve_target.transition_ticks
+			&& frame_table[next_tick] == current_frame)
+	{
+		next_tick++;
+	}
+
+	return next_tick - tick_count;
+}
+
+IlluminationSettings Baked::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	VaRGBPackedColor frame = frameAt(tick);
+	return IlluminationSettings(VaRGB_PACKEDCOLOR_RED(frame),
+			VaRGB_PACKEDCOLOR_GREEN(frame),
+			VaRGB_PACKEDCOLOR_BLUE(frame), 0);
+}
+
+} /* namespace Curve */
+} /* namespace vargb */
+
+// VaRGB_ENABLE_SCHEDULE_BAKING
+#endif
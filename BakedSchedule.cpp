@@ -0,0 +1,97 @@
+/*
+
+ BakedSchedule.cpp -- BakedSchedule implementation, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include <stdlib.h>
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_ENABLE_SCHEDULE_BAKING
+
+#include "includes/BakedSchedule.h"
+
+namespace vargb {
+
+BakedSchedule::BakedSchedule(Schedule * source, ScheduleID sched_id) :
+		Schedule(sched_id),
+		frame_table(NULL),
+		num_frames(0),
+		owns_frames(false),
+		frame_curve()
+{
+	VaRGBTimeValue total_ticks = source->totalTicks();
+	if (! total_ticks)
+	{
+		return;
+	}
+
+	VaRGBPackedColor * new_frames = (VaRGBPackedColor*) VaRGB_MALLOC(
+			sizeof(VaRGBPackedColor) * total_ticks);
+	if (new_frames == NULL)
+	{
+		// abject failure...
+		return;
+	}
+
+	num_frames = bake(source, new_frames);
+	frame_table = new_frames;
+	owns_frames = true;
+
+	frame_curve.setFrames(frame_table, num_frames);
+	addTransition(&frame_curve);
+}
+
+BakedSchedule::BakedSchedule(const VaRGBPackedColor * frames, VaRGBTimeValue frame_count,
+		ScheduleID sched_id) :
+		Schedule(sched_id),
+		frame_table(frames),
+		num_frames(frame_count),
+		owns_frames(false),
+		frame_curve(frames, frame_count)
+{
+	addTransition(&frame_curve);
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+BakedSchedule::~BakedSchedule() {
+	if (owns_frames && frame_table) {
+		VaRGB_FREE((void*)frame_table);
+	}
+}
+#endif
+
+VaRGBTimeValue BakedSchedule::bake(const Schedule * source, VaRGBPackedColor * into)
+{
+	VaRGBTimeValue total_ticks = source->totalTicks();
+
+	for (VaRGBTimeValue t = 0; t < total_ticks; t++)
+	{
+		IlluminationSettings frame = source->valueAt(t);
+		into[t] = VaRGB_PACK_COLOR(frame.values[vargb_red_idx],
+				frame.values[vargb_green_idx],
+				frame.values[vargb_blue_idx]);
+	}
+
+	return total_ticks;
+}
+
+} /* namespace vargb */
+
+// VaRGB_ENABLE_SCHEDULE_BAKING
+#endif
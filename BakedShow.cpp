@@ -0,0 +1,565 @@
+/*
+
+ BakedShow.cpp -- baked show writer and player, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "includes/BakedShow.h"
+
+// longest possible LEB128 encoding of a uint32_t
+#define bakedshow_max_varint_len		5
+
+// keep this many bytes mapped behind the decoding position
+#define bakedshow_release_margin		(64 * 1024)
+
+namespace vargb {
+
+static uint8_t encodeVarint(uint32_t value, uint8_t * into)
+{
+	uint8_t len = 0;
+	while (value >= 0x80)
+	{
+		into[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	into[len++] = value;
+	return len;
+}
+
+static bool decodeVarint(const uint8_t ** cursor, const uint8_t * end, uint32_t * value)
+{
+	uint32_t result = 0;
+	for (uint8_t shift = 0; shift < 7 * bakedshow_max_varint_len; shift += 7)
+	{
+		if (*cursor >= end)
+		{
+			return false;
+		}
+		uint8_t b = *((*cursor)++);
+		result |= ((uint32_t)(b & 0x7f)) << shift;
+		if (! (b & 0x80))
+		{
+			*value = result;
+			return true;
+		}
+	}
+
+	// corrupt: too long
+	return false;
+}
+
+static inline uint32_t zigzagEncode(int32_t value)
+{
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t zigzagDecode(uint32_t value)
+{
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+
+
+BakedShowWriter::BakedShowWriter(const char * path, VaRGBFixtureIndex fixture_count,
+		uint32_t frames_per_keyframe) :
+		out_file(NULL),
+		num_fixtures(fixture_count),
+		keyframe_interval(frames_per_keyframe ? frames_per_keyframe : 1),
+		num_frames(0),
+		offset(sizeof(BakedShowHeader)),
+		write_failed(false),
+		previous(NULL),
+		keyframe_offsets(NULL),
+		keyframe_max(0)
+{
+	previous = (ColorSettings*) VaRGB_CALLOC(num_fixtures ? num_fixtures : 1, sizeof(ColorSettings));
+	if (previous == NULL)
+	{
+		return;
+	}
+
+	out_file = fopen(path, "wb");
+	if (out_file == NULL)
+	{
+		return;
+	}
+
+	// placeholder, until we know where everything is (see close())
+	BakedShowHeader blank;
+	memset(&blank, 0, sizeof(blank));
+	if (fwrite(&blank, sizeof(blank), 1, out_file) != 1)
+	{
+		fclose(out_file);
+		out_file = NULL;
+	}
+}
+
+BakedShowWriter::~BakedShowWriter()
+{
+	if (out_file)
+	{
+		close();
+	}
+
+	if (previous)
+	{
+		VaRGB_FREE(previous);
+	}
+
+	if (keyframe_offsets)
+	{
+		VaRGB_FREE(keyframe_offsets);
+	}
+}
+
+bool BakedShowWriter::write(const void * data, size_t len)
+{
+	if (fwrite(data, 1, len, out_file) != len)
+	{
+		write_failed = true;
+		return false;
+	}
+
+	offset += len;
+	return true;
+}
+
+bool BakedShowWriter::addKeyframeOffset()
+{
+	uint32_t num_keyframes = num_frames / keyframe_interval;
+	if (num_keyframes >= keyframe_max)
+	{
+		uint32_t new_max = keyframe_max ? keyframe_max * 2 : 64;
+		uint64_t * new_offsets = (uint64_t*) VaRGB_REALLOC(keyframe_offsets, sizeof(uint64_t) * new_max);
+		if (new_offsets == NULL)
+		{
+			// abject failure...
+			write_failed = true;
+			return false;
+		}
+		keyframe_offsets = new_offsets;
+		keyframe_max = new_max;
+	}
+
+	keyframe_offsets[num_keyframes] = offset;
+	return true;
+}
+
+bool BakedShowWriter::addFrame(const ColorSettings * colors)
+{
+	if (out_file == NULL || write_failed)
+	{
+		return false;
+	}
+
+	bool is_keyframe = (num_frames % keyframe_interval == 0);
+	if (is_keyframe)
+	{
+		// keyframes are coded against all-zeros, so decoding may start there
+		if (! addKeyframeOffset())
+		{
+			return false;
+		}
+		memset(previous, 0, sizeof(ColorSettings) * num_fixtures);
+	}
+
+	uint8_t token[bakedshow_max_varint_len * (1 + VaRGB_NUM_COLORS)];
+	VaRGBFixtureIndex pos = 0;
+	for (VaRGBFixtureIndex f = 0; f < num_fixtures; f++)
+	{
+		const ColorSettings * cur = &(colors[f]);
+		ColorSettings * prev = &(previous[f]);
+		if (cur->red == prev->red && cur->green == prev->green && cur->blue == prev->blue)
+		{
+			continue;
+		}
+
+		uint8_t len = encodeVarint(f - pos, token);
+		len += encodeVarint(zigzagEncode((int32_t)cur->red - (int32_t)prev->red), &(token[len]));
+		len += encodeVarint(zigzagEncode((int32_t)cur->green - (int32_t)prev->green), &(token[len]));
+		len += encodeVarint(zigzagEncode((int32_t)cur->blue - (int32_t)prev->blue), &(token[len]));
+		if (! write(token, len))
+		{
+			return false;
+		}
+
+		*prev = *cur;
+		pos = f + 1;
+	}
+
+	if (pos < num_fixtures)
+	{
+		// skip over the trailing unchanged fixtures
+		uint8_t len = encodeVarint(num_fixtures - pos, token);
+		if (! write(token, len))
+		{
+			return false;
+		}
+	}
+
+	num_frames++;
+	return true;
+}
+
+bool BakedShowWriter::close()
+{
+	if (out_file == NULL)
+	{
+		return false;
+	}
+
+	BakedShowHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, VaRGB_BAKEDSHOW_MAGIC, sizeof(header.magic));
+	header.version = VaRGB_BAKEDSHOW_VERSION;
+	header.header_size = sizeof(BakedShowHeader);
+	header.num_fixtures = num_fixtures;
+	header.num_frames = num_frames;
+	header.keyframe_interval = keyframe_interval;
+	header.ms_per_tick = VaRGB_DELAY_BETWEEN_UPDATES_MS;
+	header.index_offset = offset;
+
+	uint32_t num_keyframes = (num_frames + keyframe_interval - 1) / keyframe_interval;
+	if (num_keyframes && ! write_failed)
+	{
+		write(keyframe_offsets, sizeof(uint64_t) * num_keyframes);
+	}
+
+	if (fseek(out_file, 0, SEEK_SET) != 0
+			|| fwrite(&header, sizeof(header), 1, out_file) != 1)
+	{
+		write_failed = true;
+	}
+
+	if (fclose(out_file) != 0)
+	{
+		write_failed = true;
+	}
+	out_file = NULL;
+
+	return ! write_failed;
+}
+
+
+
+BakedShow::BakedShow(BakedShow_SetColor_Callback set_color_with_cb,
+		BakedShow_Completed_Callback show_completed_cb) :
+		set_color_cb(set_color_with_cb),
+		completed_cb(show_completed_cb),
+		data(NULL),
+		data_len(0),
+		keyframe_index(NULL),
+		num_keyframes(0),
+		released_upto(0),
+		cursor(NULL),
+		current_frame(0),
+		colors(NULL),
+		changed(NULL)
+{
+	memset(&header, 0, sizeof(header));
+}
+
+BakedShow::~BakedShow()
+{
+	close();
+}
+
+void BakedShow::close()
+{
+	if (data)
+	{
+		munmap((void*)data, data_len);
+		data = NULL;
+	}
+
+	if (colors)
+	{
+		VaRGB_FREE(colors);
+		colors = NULL;
+	}
+
+	if (changed)
+	{
+		VaRGB_FREE(changed);
+		changed = NULL;
+	}
+
+	memset(&header, 0, sizeof(header));
+	current_frame = 0;
+}
+
+bool BakedShow::open(const char * path)
+{
+	close();
+
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat file_info;
+	if (fstat(fd, &file_info) != 0 || file_info.st_size < (off_t)sizeof(BakedShowHeader))
+	{
+		::close(fd);
+		return false;
+	}
+
+	data_len = file_info.st_size;
+	void * mapping = mmap(NULL, data_len, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		return false;
+	}
+	data = (const uint8_t*)mapping;
+
+	memcpy(&header, data, sizeof(header));
+	num_keyframes = header.keyframe_interval ?
+			(header.num_frames + header.keyframe_interval - 1) / header.keyframe_interval : 0;
+
+	if (memcmp(header.magic, VaRGB_BAKEDSHOW_MAGIC, sizeof(header.magic)) != 0
+			|| header.version != VaRGB_BAKEDSHOW_VERSION
+			|| header.header_size != sizeof(BakedShowHeader)
+			|| header.keyframe_interval < 1
+			|| header.num_frames < 1
+			|| header.num_fixtures > (VaRGBFixtureIndex)-1
+			|| header.index_offset < sizeof(BakedShowHeader)
+			|| header.index_offset + (sizeof(uint64_t) * num_keyframes) > data_len)
+	{
+		// not a show we can play
+		close();
+		return false;
+	}
+
+	keyframe_index = data + header.index_offset;
+
+	colors = (ColorSettings*) VaRGB_CALLOC(header.num_fixtures ? header.num_fixtures : 1, sizeof(ColorSettings));
+	changed = (uint8_t*) VaRGB_CALLOC((header.num_fixtures / 8) + 1, 1);
+	if (colors == NULL || changed == NULL)
+	{
+		close();
+		return false;
+	}
+
+	// we read through the show front to back
+	madvise((void*)data, data_len, MADV_SEQUENTIAL);
+	released_upto = 0;
+
+	// everybody gets an initial color
+	memset(changed, 0xff, (header.num_fixtures / 8) + 1);
+	seek(0);
+
+	return true;
+}
+
+void BakedShow::currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into)
+{
+	*into = colors[fixture];
+}
+
+bool BakedShow::decodeFrame()
+{
+	const uint8_t * end = data + header.index_offset;
+	VaRGBFixtureIndex num_fixtures = header.num_fixtures;
+	uint32_t pos = 0;
+
+	while (pos < num_fixtures)
+	{
+		uint32_t skip;
+		if (! decodeVarint(&cursor, end, &skip))
+		{
+			return false;
+		}
+
+		pos += skip;
+		if (pos >= num_fixtures)
+		{
+			break;
+		}
+
+		ColorSettings * color = &(colors[pos]);
+		uint32_t deltas[VaRGB_NUM_COLORS];
+		for (uint8_t c = 0; c < VaRGB_NUM_COLORS; c++)
+		{
+			if (! decodeVarint(&cursor, end, &(deltas[c])))
+			{
+				return false;
+			}
+		}
+		color->red += zigzagDecode(deltas[vargb_red_idx]);
+		color->green += zigzagDecode(deltas[vargb_green_idx]);
+		color->blue += zigzagDecode(deltas[vargb_blue_idx]);
+
+		markChanged(pos);
+		pos++;
+	}
+
+	return true;
+}
+
+bool BakedShow::advanceFrame()
+{
+	uint32_t next_frame = current_frame + 1;
+	if (next_frame % header.keyframe_interval == 0)
+	{
+		// keyframes aren't relative to the frame before
+		return startAtKeyframe(next_frame / header.keyframe_interval);
+	}
+
+	if (! decodeFrame())
+	{
+		return false;
+	}
+
+	current_frame = next_frame;
+	return true;
+}
+
+bool BakedShow::startAtKeyframe(uint32_t keyframe)
+{
+	uint64_t keyframe_offset;
+	memcpy(&keyframe_offset, keyframe_index + (keyframe * sizeof(uint64_t)), sizeof(keyframe_offset));
+	cursor = data + keyframe_offset;
+
+	// keyframes are coded against all-zeros
+	for (VaRGBFixtureIndex f = 0; f < header.num_fixtures; f++)
+	{
+		ColorSettings * color = &(colors[f]);
+		if (color->red || color->green || color->blue)
+		{
+			color->red = color->green = color->blue = 0;
+			markChanged(f);
+		}
+	}
+
+	current_frame = keyframe * header.keyframe_interval;
+	return decodeFrame();
+}
+
+void BakedShow::dispatchChanged()
+{
+	VaRGBFixtureIndex num_fixtures = header.num_fixtures;
+	for (uint32_t byte_idx = 0; byte_idx <= (uint32_t)(num_fixtures / 8); byte_idx++)
+	{
+		if (! changed[byte_idx])
+		{
+			continue;
+		}
+
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			uint32_t fixture = (byte_idx * 8) + bit;
+			if (fixture < num_fixtures && (changed[byte_idx] & (1 << bit)) && set_color_cb)
+			{
+				set_color_cb(fixture, &(colors[fixture]));
+			}
+		}
+		changed[byte_idx] = 0;
+	}
+}
+
+void BakedShow::releaseBehind()
+{
+	// hand back the pages we've played through, so resident memory
+	// stays small however long the show.
+	static size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t position = cursor - data;
+	if (position < bakedshow_release_margin)
+	{
+		return;
+	}
+
+	size_t release_to = ((position - bakedshow_release_margin) / page_size) * page_size;
+	if (release_to > released_upto)
+	{
+		madvise((void*)(data + released_upto), release_to - released_upto, MADV_DONTNEED);
+		released_upto = release_to;
+	} else if (release_to < released_upto)
+	{
+		// went backwards: those pages fault back in as needed
+		released_upto = release_to;
+	}
+}
+
+void BakedShow::seek(uint32_t frame)
+{
+	if (! data)
+	{
+		return;
+	}
+
+	frame %= header.num_frames;
+
+	startAtKeyframe(frame / header.keyframe_interval);
+	while (current_frame < frame && advanceFrame())
+	{
+	}
+
+	dispatchChanged();
+	releaseBehind();
+}
+
+void BakedShow::tick(uint32_t num)
+{
+	if (! data || ! num)
+	{
+		return;
+	}
+
+	uint64_t target = (uint64_t)current_frame + num;
+	if (target >= header.num_frames)
+	{
+		// reached the end (perhaps more than once)
+		uint64_t num_completions = target / header.num_frames;
+		for (uint64_t i = 0; i < num_completions && completed_cb; i++)
+		{
+			completed_cb();
+		}
+		seek(target % header.num_frames);
+		return;
+	}
+
+	if ((target - current_frame) > (target % header.keyframe_interval) + 1)
+	{
+		// quicker to start over from the closest keyframe
+		seek(target);
+		return;
+	}
+
+	while (current_frame < target && advanceFrame())
+	{
+	}
+
+	dispatchChanged();
+	releaseBehind();
+}
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
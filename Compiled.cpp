@@ -0,0 +1,488 @@
+/*
+
+ Compiled.cpp -- flattened logic curve trees, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_ENABLE_CURVE_COMPILEDLOGIC
+
+#ifndef VaRGB_ENABLE_CURVE_LOGICAL
+#error "VaRGB_ENABLE_CURVE_COMPILEDLOGIC defined but not VaRGB_ENABLE_CURVE_LOGICAL (see config)"
+#endif
+
+#include <stdlib.h>
+#include "includes/Curves/Compiled.h"
+
+namespace vargb {
+namespace Curve {
+
+Compiled::Compiled(vargb::Curve::Curve * tree) :
+		Curve(0, 0, 0, 0),
+		leaves(NULL),
+		program(NULL),
+		slots(NULL),
+		num_leaves(0),
+		num_instructions(0),
+		result_slot(0),
+		value_depth(0)
+{
+	curve_target = *(tree->target());
+
+	// size everything for the worst case (no leaf used twice)
+	uint16_t num_nodes = 0;
+	if (! countNodes(tree, &num_nodes) || num_nodes > VaRGB_COMPILED_MAX_SLOTS)
+	{
+		return;
+	}
+
+	leaves = (vargb::Curve::Curve**) VaRGB_MALLOC(sizeof(vargb::Curve::Curve*) * num_nodes);
+	program = (LogicInstruction*) VaRGB_MALLOC(sizeof(LogicInstruction) * num_nodes);
+	if (! (leaves && program))
+	{
+		return;
+	}
+
+	// leaves get the first slots, so we need to know how many there are
+	// before placing instructions: gather them first, then emit.
+	gatherLeaves(tree);
+
+	result_slot = emit(tree);
+	value_depth = valueDepth();
+
+	// slots last, as valid() depends on it
+	slots = (IlluminationSettings*) VaRGB_MALLOC(sizeof(IlluminationSettings) * (num_leaves + num_instructions));
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+Compiled::~Compiled()
+{
+	if (leaves) {
+		VaRGB_FREE(leaves);
+	}
+	if (program) {
+		VaRGB_FREE(program);
+	}
+	if (slots) {
+		VaRGB_FREE(slots);
+	}
+}
+#endif
+
+bool Compiled::countNodes(vargb::Curve::Curve * node, uint16_t * num_nodes)
+{
+	(*num_nodes)++;
+
+	Logic * logic = node->asLogic();
+	if (logic)
+	{
+		if (! logic->valid())
+		{
+			// no operands to compile
+			return false;
+		}
+
+		for (uint8_t i = 0; i < logic->numChildren(); i++)
+		{
+			if (! countNodes(logic->child(i), num_nodes))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void Compiled::gatherLeaves(vargb::Curve::Curve * node)
+{
+	Logic * logic = node->asLogic();
+	if (logic)
+	{
+		for (uint8_t i = 0; i < logic->numChildren(); i++)
+		{
+			gatherLeaves(logic->child(i));
+		}
+		return;
+	}
+
+	for (uint8_t i = 0; i < num_leaves; i++)
+	{
+		if (leaves[i] == node)
+		{
+			// already have it
+			return;
+		}
+	}
+	leaves[num_leaves++] = node;
+}
+
+uint8_t Compiled::emit(vargb::Curve::Curve * node)
+{
+	Logic * logic = node->asLogic();
+	if (! logic)
+	{
+		for (uint8_t i = 0; i < num_leaves; i++)
+		{
+			if (leaves[i] == node)
+			{
+				return i;
+			}
+		}
+		return 0; // can't happen: all leaves were gathered
+	}
+
+	// children first, so their slots are ready when we run
+	LogicInstruction instruction;
+	instruction.opcode = LogicOpCustom;
+	instruction.channels = 0;
+	instruction.value = 0;
+	instruction.alt_value = 0;
+	instruction.node = logic;
+	instruction.num_operands = logic->numChildren();
+	for (uint8_t i = 0; i < instruction.num_operands; i++)
+	{
+		instruction.operands[i] = emit(logic->child(i));
+	}
+
+	logic->describe(&instruction);
+
+	program[num_instructions] = instruction;
+	return num_leaves + num_instructions++;
+}
+
+void Compiled::run(IlluminationSettings * with_slots) const
+{
+	const IlluminationSettings * operands[VARGB_CURVE_LOGIC_NUMCURVES];
+
+	for (uint8_t pc = 0; pc < num_instructions; pc++)
+	{
+		const LogicInstruction * instr = &(program[pc]);
+		for (uint8_t op = 0; op < instr->num_operands; op++)
+		{
+			operands[op] = &(with_slots[instr->operands[op]]);
+		}
+
+		execute(instr, operands, &(with_slots[num_leaves + pc]));
+	}
+}
+
+void Compiled::execute(const LogicInstruction * instr, const IlluminationSettings * operands[],
+		IlluminationSettings * result) const
+{
+	const VaRGBColorValue * a = operands[0]->values;
+
+	switch (instr->opcode)
+	{
+	case LogicOpAnd:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i];
+			for (uint8_t op = 1; op < instr->num_operands; op++)
+			{
+				result->values[i] &= operands[op]->values[i];
+			}
+		}
+		break;
+
+	case LogicOpOr:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i];
+			for (uint8_t op = 1; op < instr->num_operands; op++)
+			{
+				result->values[i] |= operands[op]->values[i];
+			}
+		}
+		break;
+
+	case LogicOpNot:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = (instr->channels & (1 << i)) ?
+					(VaRGB_COLOR_MAXVALUE & (~(a[i]))) : a[i];
+		}
+		break;
+
+	case LogicOpShiftLeft:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i] << instr->value;
+		}
+		break;
+
+	case LogicOpShiftRight:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i] >> instr->value;
+		}
+		break;
+
+	case LogicOpThresholdAbove:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i] > instr->value ? a[i] : instr->alt_value;
+		}
+		break;
+
+	case LogicOpThresholdBelow:
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			result->values[i] = a[i] < instr->value ? a[i] : instr->alt_value;
+		}
+		break;
+
+	default:
+		// some other Logic: let it combine the operands itself
+		instr->node->combine(operands, result);
+		break;
+	}
+}
+
+uint8_t Compiled::valueDepth() const
+{
+	// the program is in post-order, each instruction's result being used
+	// by exactly one later instruction: intermediate results come and go
+	// like on a stack, the operands of each instruction on top.
+	uint8_t depth = 0;
+	uint8_t max_depth = 0;
+	for (uint8_t pc = 0; pc < num_instructions; pc++)
+	{
+		for (uint8_t op = 0; op < program[pc].num_operands; op++)
+		{
+			if (program[pc].operands[op] >= num_leaves)
+			{
+				depth--;
+			}
+		}
+
+		if (++depth > max_depth)
+		{
+			max_depth = depth;
+		}
+	}
+
+	return max_depth;
+}
+
+void Compiled::update()
+{
+	for (uint8_t i = 0; i < num_leaves; i++)
+	{
+		slots[i] = *(leaves[i]->currentSettings());
+	}
+
+	run(slots);
+
+	IlluminationSettings * result = &(slots[result_slot]);
+	current_settings.values[vargb_red_idx] = result->values[vargb_red_idx];
+	current_settings.values[vargb_green_idx] = result->values[vargb_green_idx];
+	current_settings.values[vargb_blue_idx] = result->values[vargb_blue_idx];
+}
+
+bool Compiled::completed()
+{
+	if (! valid())
+	{
+		// nothing to run, like an invalid Logic
+		return true;
+	}
+
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		if (leaves[i]->completed())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+VaRGBTimeValue Compiled::ticksRemaining()
+{
+	if (! valid())
+	{
+		return 0;
+	}
+
+	VaRGBTimeValue remaining = VaRGB_TIMEVALUE_MAX;
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		VaRGBTimeValue leaf_remaining = leaves[i]->ticksRemaining();
+		if (leaf_remaining < remaining)
+		{
+			remaining = leaf_remaining;
+		}
+	}
+
+	return remaining;
+}
+
+VaRGBTimeValue Compiled::ticksUntilNextChange()
+{
+	VaRGBTimeValue next_change = VaRGB_TIMEVALUE_MAX;
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		VaRGBTimeValue leaf_next = leaves[i]->ticksUntilNextChange();
+		if (leaf_next < next_change)
+		{
+			next_change = leaf_next;
+		}
+	}
+
+	return next_change;
+}
+
+void Compiled::settingsUpdated()
+{
+	settings_req_update = false;
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		leaves[i]->settingsUpdated();
+	}
+}
+
+void Compiled::start(IlluminationSettings* initial_settings)
+{
+	if (! valid())
+	{
+		return;
+	}
+
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		leaves[i]->start(initial_settings);
+	}
+
+	update();
+	settings_req_update = true;
+}
+
+void Compiled::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
+{
+	if (! valid())
+	{
+		return;
+	}
+
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		leaves[i]->setTick(setTo, initial_settings);
+	}
+
+	update();
+	settings_req_update = true;
+}
+
+void Compiled::tick(VaRGBTimeValue num)
+{
+	if (! valid())
+	{
+		return;
+	}
+
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		leaves[i]->tick(num);
+		if (leaves[i]->settingsNeedUpdate()) {
+			settings_req_update = true;
+		}
+	}
+
+	if (settings_req_update) {
+		update();
+	}
+}
+
+IlluminationSettings Compiled::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	IlluminationSettings value;
+	if (! slots)
+	{
+		return value;
+	}
+
+	if (! num_instructions)
+	{
+		// a lone leaf
+		return leaves[result_slot]->valueAt(tick, start_settings);
+	}
+
+	if (value_depth > VaRGB_COMPILED_STACK_SLOTS)
+	{
+		// too deep for the stack: work in our own slots, which update()
+		// entirely refills before using them anyway.
+		for (uint8_t i = 0; i < num_leaves; i++)
+		{
+			slots[i] = leaves[i]->valueAt(tick, start_settings);
+		}
+		run(slots);
+		value = slots[result_slot];
+		return value;
+	}
+
+	// run the program on a stack of intermediate results, evaluating
+	// the leaves as they're needed, so we don't disturb the running
+	// state and need no memory beyond this.
+	IlluminationSettings stack[VaRGB_COMPILED_STACK_SLOTS];
+	IlluminationSettings leaf_values[VARGB_CURVE_LOGIC_NUMCURVES];
+	const IlluminationSettings * operands[VARGB_CURVE_LOGIC_NUMCURVES];
+	uint8_t depth = 0;
+
+	for (uint8_t pc = 0; pc < num_instructions; pc++)
+	{
+		const LogicInstruction * instr = &(program[pc]);
+
+		// the instruction's own operands are on top of the stack, in order
+		uint8_t num_stacked = 0;
+		for (uint8_t op = 0; op < instr->num_operands; op++)
+		{
+			if (instr->operands[op] >= num_leaves)
+			{
+				num_stacked++;
+			}
+		}
+		depth -= num_stacked;
+
+		uint8_t stacked = depth;
+		for (uint8_t op = 0; op < instr->num_operands; op++)
+		{
+			if (instr->operands[op] >= num_leaves)
+			{
+				operands[op] = &(stack[stacked++]);
+			} else {
+				leaf_values[op] = leaves[instr->operands[op]]->valueAt(tick, start_settings);
+				operands[op] = &(leaf_values[op]);
+			}
+		}
+
+		execute(instr, operands, &value);
+		stack[depth++] = value;
+	}
+
+	return value;
+}
+
+void Compiled::reset()
+{
+	for (uint8_t i = 0; i < num_leaves; i++) {
+		leaves[i]->reset();
+	}
+}
+
+} /* namespace Curve */
+} /* namespace vargb */
+
+#endif /* VaRGB_ENABLE_CURVE_COMPILEDLOGIC */
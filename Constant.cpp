@@ -60,7 +60,7 @@ void Constant::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_setti
 
 }
 
-void Constant::tick(uint8_t num)
+void Constant::tick(VaRGBTimeValue num)
 {
 
 	for (uint8_t c = 0; c < VaRGB_NUM_COLORS; c++) {
@@ -77,6 +77,21 @@ void Constant::tick(uint8_t num)
 	}
 }
 
+VaRGBTimeValue Constant::ticksUntilNextChange()
+{
+	// nothing to do but complete
+	VaRGBTimeValue remaining = ticksRemaining();
+	return remaining ? remaining : 1;
+}
+
+IlluminationSettings Constant::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	return IlluminationSettings(curve_target.values[vargb_red_idx],
+			curve_target.values[vargb_green_idx],
+			curve_target.values[vargb_blue_idx], 0);
+}
+
 
 } /* namespace Curve */
 } /* namespace vargb */
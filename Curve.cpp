@@ -50,7 +50,9 @@ Curve::Curve(VaRGBColorValue target_red, VaRGBColorValue target_green,
 				target_green, target_blue, trans_time_seconds),
 				current_settings()
 {
-
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+	tick_frame = 0;
+#endif
 }
 
 #ifdef  VaRGB_CLASS_DESTRUCTORS_ENABLE
@@ -72,6 +74,17 @@ void Curve::reset()
 	curve_completed = false;
 	tick_count = 0;
 }
+
+VaRGBTimeValue Curve::ticksRemaining()
+{
+	if (curve_completed || tick_count >= curve_target.transition_ticks)
+	{
+		return 0;
+	}
+
+	return curve_target.transition_ticks - tick_count;
+}
+
 void Curve::start(IlluminationSettings* initial_settings)
 {
 	reset();
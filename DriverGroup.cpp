@@ -0,0 +1,327 @@
+/*
+
+ DriverGroup.cpp -- timer-wheel scheduling of many VaRGB drivers, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "includes/DriverGroup.h"
+
+#define group_slot_mask				(VaRGB_DRIVERGROUP_WHEEL_SLOTS - 1)
+#define group_level_shift(level)		((level) * VaRGB_DRIVERGROUP_WHEEL_BITS)
+#define group_level_span(level)		(((VaRGBTickCount)1) << group_level_shift(level))
+
+namespace vargb {
+
+DriverGroup::DriverGroup(VaRGBFixtureIndex max_num_drivers, DriverGroup_Frame_Callback frame_callback) :
+		max_drivers(max_num_drivers),
+		num_drivers(0),
+		num_touched(0),
+		now(0),
+		frame_cb(frame_callback),
+		frame_buffer(NULL),
+		dirty_bits(NULL),
+		owns_frame(frame_callback != NULL),
+		drivers(NULL),
+		due_tick(NULL),
+		synced_tick(NULL),
+		next_entry(NULL),
+		prev_entry(NULL),
+		entry_slot(NULL)
+{
+	if (frame_cb)
+	{
+		frame_buffer = (ColorSettings*) VaRGB_MALLOC(sizeof(ColorSettings) * max_drivers);
+		dirty_bits = (uint8_t*) VaRGB_MALLOC((max_drivers + 7) / 8);
+		if (! (frame_buffer && dirty_bits))
+		{
+			return;
+		}
+		memset(frame_buffer, 0, sizeof(ColorSettings) * max_drivers);
+		memset(dirty_bits, 0, (max_drivers + 7) / 8);
+	}
+
+	allocate();
+}
+
+DriverGroup::DriverGroup(VaRGBFixtureIndex max_num_drivers, ColorSettings * frame_into, uint8_t * dirty_bits_into) :
+		max_drivers(max_num_drivers),
+		num_drivers(0),
+		num_touched(0),
+		now(0),
+		frame_cb(NULL),
+		frame_buffer(frame_into),
+		dirty_bits(dirty_bits_into),
+		owns_frame(false),
+		drivers(NULL),
+		due_tick(NULL),
+		synced_tick(NULL),
+		next_entry(NULL),
+		prev_entry(NULL),
+		entry_slot(NULL)
+{
+	allocate();
+}
+
+void DriverGroup::allocate()
+{
+	for (uint8_t level = 0; level < VaRGB_DRIVERGROUP_WHEEL_LEVELS; level++)
+	{
+		for (uint8_t slot = 0; slot < VaRGB_DRIVERGROUP_WHEEL_SLOTS; slot++)
+		{
+			wheel[level][slot] = VaRGB_DRIVERGROUP_INVALID_INDEX;
+		}
+	}
+
+	due_tick = (VaRGBTickCount*) VaRGB_MALLOC(sizeof(VaRGBTickCount) * max_drivers);
+	synced_tick = (VaRGBTickCount*) VaRGB_MALLOC(sizeof(VaRGBTickCount) * max_drivers);
+	next_entry = (VaRGBFixtureIndex*) VaRGB_MALLOC(sizeof(VaRGBFixtureIndex) * max_drivers);
+	prev_entry = (VaRGBFixtureIndex*) VaRGB_MALLOC(sizeof(VaRGBFixtureIndex) * max_drivers);
+	entry_slot = (VaRGBFixtureIndex**) VaRGB_MALLOC(sizeof(VaRGBFixtureIndex*) * max_drivers);
+
+	if (due_tick && synced_tick && next_entry && prev_entry && entry_slot)
+	{
+		// drivers last, as valid() depends on it
+		drivers = (VaRGB**) VaRGB_MALLOC(sizeof(VaRGB*) * max_drivers);
+	}
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+DriverGroup::~DriverGroup()
+{
+	if (drivers) {
+		VaRGB_FREE(drivers);
+	}
+	if (due_tick) {
+		VaRGB_FREE(due_tick);
+	}
+	if (synced_tick) {
+		VaRGB_FREE(synced_tick);
+	}
+	if (next_entry) {
+		VaRGB_FREE(next_entry);
+	}
+	if (prev_entry) {
+		VaRGB_FREE(prev_entry);
+	}
+	if (entry_slot) {
+		VaRGB_FREE(entry_slot);
+	}
+	if (owns_frame && frame_buffer) {
+		VaRGB_FREE(frame_buffer);
+	}
+	if (owns_frame && dirty_bits) {
+		VaRGB_FREE(dirty_bits);
+	}
+}
+#endif
+
+VaRGBFixtureIndex DriverGroup::add(VaRGB * driver)
+{
+	if (! valid() || num_drivers >= max_drivers)
+	{
+		return VaRGB_DRIVERGROUP_INVALID_INDEX;
+	}
+
+	VaRGBFixtureIndex idx = num_drivers++;
+	drivers[idx] = driver;
+	if (frame_buffer)
+	{
+		// batched output: the driver writes to its slot in the frame
+		driver->setFrameOutput(&(frame_buffer[idx]), dirty_bits, idx);
+		driver->refreshColor();
+	}
+	synced_tick[idx] = now;
+	due_tick[idx] = now + driver->ticksUntilNextChange();
+	insert(idx);
+
+	return idx;
+}
+
+VaRGBFixtureIndex * DriverGroup::slotFor(VaRGBTickCount due)
+{
+	// the lowest level whose span covers the wait
+	VaRGBTickCount wait = due - now;
+	uint8_t level = 0;
+	while (level < (VaRGB_DRIVERGROUP_WHEEL_LEVELS - 1)
+			&& wait >= group_level_span(level + 1))
+	{
+		level++;
+	}
+
+	return &(wheel[level][(due >> group_level_shift(level)) & group_slot_mask]);
+}
+
+void DriverGroup::insert(VaRGBFixtureIndex idx)
+{
+	VaRGBFixtureIndex * head = slotFor(due_tick[idx]);
+
+	entry_slot[idx] = head;
+	prev_entry[idx] = VaRGB_DRIVERGROUP_INVALID_INDEX;
+	next_entry[idx] = *head;
+	if (*head != VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		prev_entry[*head] = idx;
+	}
+	*head = idx;
+}
+
+void DriverGroup::unlink(VaRGBFixtureIndex idx)
+{
+	if (prev_entry[idx] != VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		next_entry[prev_entry[idx]] = next_entry[idx];
+	} else {
+		// we're at the head of our slot's list (which need not be the
+		// slot our due tick would map to now)
+		*(entry_slot[idx]) = next_entry[idx];
+	}
+
+	if (next_entry[idx] != VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		prev_entry[next_entry[idx]] = prev_entry[idx];
+	}
+}
+
+void DriverGroup::catchUp(VaRGBFixtureIndex idx)
+{
+	VaRGBTickCount pending = now - synced_tick[idx];
+	while (pending > 0)
+	{
+		VaRGBTimeValue step = pending > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : pending;
+		drivers[idx]->tick(step);
+		pending -= step;
+	}
+	synced_tick[idx] = now;
+}
+
+void DriverGroup::reschedule(VaRGBFixtureIndex idx)
+{
+	if (idx >= num_drivers)
+	{
+		return;
+	}
+
+	unlink(idx);
+	catchUp(idx);
+	due_tick[idx] = now + drivers[idx]->ticksUntilNextChange();
+	insert(idx);
+}
+
+void DriverGroup::sync()
+{
+	for (VaRGBFixtureIndex idx = 0; idx < num_drivers; idx++)
+	{
+		catchUp(idx);
+	}
+}
+
+void DriverGroup::cascade(uint8_t level)
+{
+	// everything in this slot is now due within the span of the
+	// level below: re-file it all there.
+	VaRGBFixtureIndex * head = &(wheel[level][(now >> group_level_shift(level)) & group_slot_mask]);
+	VaRGBFixtureIndex idx = *head;
+	*head = VaRGB_DRIVERGROUP_INVALID_INDEX;
+
+	while (idx != VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		VaRGBFixtureIndex next_idx = next_entry[idx];
+		insert(idx);
+		idx = next_idx;
+	}
+}
+
+void DriverGroup::tickOnce()
+{
+	now++;
+
+	// when a level wraps around, the next slot up comes down a level
+	for (uint8_t level = VaRGB_DRIVERGROUP_WHEEL_LEVELS - 1; level > 0; level--)
+	{
+		if ((now & (group_level_span(level) - 1)) == 0)
+		{
+			cascade(level);
+		}
+	}
+
+	VaRGBFixtureIndex * head = &(wheel[0][now & group_slot_mask]);
+	VaRGBFixtureIndex idx = *head;
+	*head = VaRGB_DRIVERGROUP_INVALID_INDEX;
+
+	while (idx != VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		VaRGBFixtureIndex next_idx = next_entry[idx];
+
+		catchUp(idx);
+		num_touched++;
+
+		due_tick[idx] = now + drivers[idx]->ticksUntilNextChange();
+		insert(idx);
+
+		idx = next_idx;
+	}
+}
+
+void DriverGroup::tick(VaRGBTimeValue num)
+{
+	if (! valid())
+	{
+		return;
+	}
+
+	num_touched = 0;
+	for (VaRGBTimeValue i = 0; i < num; i++)
+	{
+		tickOnce();
+	}
+
+	if (frame_cb)
+	{
+		sendFrame();
+	}
+}
+
+void DriverGroup::sendFrame()
+{
+	frame_cb(frame_buffer, dirty_bits, num_drivers);
+	memset(dirty_bits, 0, (num_drivers + 7) / 8);
+}
+
+void DriverGroup::tickAndDelay(VaRGBTimeValue num)
+{
+	tick(num);
+	vargb::delayMs(num * VaRGB::tickDelayTimeMs());
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+void DriverGroup::tickAndWait(TickClock * clock)
+{
+	VaRGBTickCount elapsed = clock->waitForTicks();
+
+	while (elapsed > 0)
+	{
+		VaRGBTimeValue num = elapsed > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : elapsed;
+		tick(num);
+		elapsed -= num;
+	}
+}
+#endif
+
+} /* namespace vargb */
@@ -0,0 +1,194 @@
+/*
+
+ FanOut.cpp -- one schedule driving many fixtures, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "includes/FanOut.h"
+#include "VaRGB.h"
+
+namespace vargb {
+
+FanOut::FanOut(const Schedule * sched, VaRGBFixtureIndex num, FanOut_SetColor_Callback set_color_with_cb) :
+		schedule(sched),
+		num_fixtures(num),
+		set_color_cb(set_color_with_cb),
+		position(0),
+		refresh_all(true),
+		offsets(NULL),
+		scales(NULL),
+		last_colors(NULL)
+{
+	last_colors = (VaRGBPackedColor*) VaRGB_MALLOC(sizeof(VaRGBPackedColor) * num_fixtures);
+	if (! last_colors)
+	{
+		return;
+	}
+	memset(last_colors, 0, sizeof(VaRGBPackedColor) * num_fixtures);
+
+	// offsets last, as valid() depends on it
+	offsets = (VaRGBTimeValue*) VaRGB_MALLOC(sizeof(VaRGBTimeValue) * num_fixtures);
+	if (offsets)
+	{
+		memset(offsets, 0, sizeof(VaRGBTimeValue) * num_fixtures);
+	}
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+FanOut::~FanOut()
+{
+	if (offsets) {
+		VaRGB_FREE(offsets);
+	}
+	if (scales) {
+		VaRGB_FREE(scales);
+	}
+	if (last_colors) {
+		VaRGB_FREE(last_colors);
+	}
+}
+#endif
+
+void FanOut::setSchedule(const Schedule * sched)
+{
+	schedule = sched;
+	position = 0;
+	refresh_all = true;
+}
+
+void FanOut::spreadOffsets(VaRGBTimeValue step)
+{
+	for (VaRGBFixtureIndex i = 0; i < num_fixtures; i++)
+	{
+		offsets[i] = (VaRGBTimeValue)(step * i);
+	}
+}
+
+bool FanOut::setScale(VaRGBFixtureIndex fixture, uint16_t scale)
+{
+	if (! scales)
+	{
+		scales = (uint16_t*) VaRGB_MALLOC(sizeof(uint16_t) * num_fixtures);
+		if (! scales)
+		{
+			return false;
+		}
+		for (VaRGBFixtureIndex i = 0; i < num_fixtures; i++)
+		{
+			scales[i] = VaRGB_FANOUT_SCALE_ONE;
+		}
+	}
+
+	scales[fixture] = scale;
+	return true;
+}
+
+void FanOut::currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into)
+{
+	into->red = VaRGB_PACKEDCOLOR_RED(last_colors[fixture]);
+	into->green = VaRGB_PACKEDCOLOR_GREEN(last_colors[fixture]);
+	into->blue = VaRGB_PACKEDCOLOR_BLUE(last_colors[fixture]);
+}
+
+void FanOut::update(bool force)
+{
+	if (! (valid() && schedule && schedule->totalTicks()))
+	{
+		return;
+	}
+
+	VaRGBTimeValue total = schedule->totalTicks();
+	ColorSettings color;
+
+	for (VaRGBFixtureIndex i = 0; i < num_fixtures; i++)
+	{
+		VaRGBTimeProduct fixture_position = position;
+		if (scales)
+		{
+			fixture_position = (VaRGBTimeProduct)(((uint64_t)position * scales[i]) / VaRGB_FANOUT_SCALE_ONE);
+		}
+
+		IlluminationSettings illum = schedule->valueAt((fixture_position + offsets[i]) % total);
+		VaRGBPackedColor packed = VaRGB_PACK_COLOR(illum.values[vargb_red_idx],
+				illum.values[vargb_green_idx], illum.values[vargb_blue_idx]);
+
+		if (force || packed != last_colors[i])
+		{
+			last_colors[i] = packed;
+			color.red = illum.values[vargb_red_idx];
+			color.green = illum.values[vargb_green_idx];
+			color.blue = illum.values[vargb_blue_idx];
+			set_color_cb(i, &color);
+		}
+	}
+}
+
+void FanOut::start()
+{
+	position = 0;
+	update(true);
+	refresh_all = false;
+}
+
+void FanOut::tick(VaRGBTimeValue num)
+{
+	if (! (schedule && schedule->totalTicks()))
+	{
+		return;
+	}
+
+	if (refresh_all)
+	{
+		// not start()ed: this tick shows where the schedule begins, rather
+		// than moving past it unseen
+		update(true);
+		refresh_all = false;
+		return;
+	}
+
+	// every fixture is back where it started after this many ticks (the
+	// schedule's length, times the scale denominator when scales are in use)
+	VaRGBTimeProduct period = (VaRGBTimeProduct)schedule->totalTicks() * (scales ? VaRGB_FANOUT_SCALE_ONE : 1);
+	position = (position + num) % period;
+
+	update(false);
+}
+
+void FanOut::tickAndDelay(VaRGBTimeValue num)
+{
+	tick(num);
+	vargb::delayMs(num * VaRGB::tickDelayTimeMs());
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+void FanOut::tickAndWait(TickClock * clock)
+{
+	VaRGBTickCount elapsed = clock->waitForTicks();
+
+	while (elapsed > 0)
+	{
+		VaRGBTimeValue num = elapsed > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : elapsed;
+		tick(num);
+		elapsed -= num;
+	}
+}
+#endif
+
+} /* namespace vargb */
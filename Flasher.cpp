@@ -40,8 +40,8 @@ Flasher::Flasher(VaRGBColorValue target_red, VaRGBColorValue target_green,
 		uint8_t numFlashes) :
 		Curve(target_red, target_green, target_blue, time_seconds),
 		num_flashes(numFlashes),
-		toggle_interval(1),
-		is_flashing(false)
+		is_flashing(false),
+		toggle_interval(1)
 {
 
 	if (num_flashes < 1)
@@ -63,11 +63,7 @@ void Flasher::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settin
 
 	resetCurrentSettings(initial_settings);
 
-	toggle_interval = curve_target.transition_ticks / (2 * num_flashes);
-	if (toggle_interval < 1)
-	{
-		toggle_interval = 1;
-	}
+	toggle_interval = toggleInterval();
 
 	if ((setTo / toggle_interval) % 2 == 0)
 	{
@@ -87,37 +83,69 @@ void Flasher::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settin
 
 }
 
-void Flasher::tick(uint8_t num)
+void Flasher::tick(VaRGBTimeValue num)
 {
-	for (uint8_t i=0; i<num; i++)
-	{
-		tick_count++;
+	VaRGBTimeValue new_count = tick_count + num;
 
-		if (tick_count >= curve_target.transition_ticks)
+	if ((new_count / toggle_interval) != (tick_count / toggle_interval))
+	{
+		// we've hit at least one toggle point--where we end up only depends
+		// on how many toggle intervals have gone by since the start.
+		is_flashing = ((new_count / toggle_interval) % 2 != 0);
+		if (is_flashing)
 		{
-			curve_completed = true;
+			resetCurrentSettings(&curve_target);
+		} else {
+			resetCurrentSettings(&base_settings);
 		}
-		if (tick_count % toggle_interval == 0)
-		{
-			if (is_flashing)
-			{
-				// is flashing, reset to base
-				resetCurrentSettings(&base_settings);
-			} else {
 
-				// not flashing, reset to flash on
-				resetCurrentSettings(&curve_target);
-			}
+		settings_req_update = true;
+	}
 
-			is_flashing = !is_flashing;
-			settings_req_update = true;
+	tick_count = new_count;
 
-		}
+	if (tick_count >= curve_target.transition_ticks)
+	{
+		curve_completed = true;
 	}
 
 }
 
+VaRGBTimeValue Flasher::ticksUntilNextChange()
+{
+	VaRGBTimeValue until_toggle = toggle_interval - (tick_count % toggle_interval);
+	VaRGBTimeValue remaining = ticksRemaining();
+
+	if (remaining && remaining < until_toggle)
+	{
+		return remaining;
+	}
 
+	return until_toggle;
+}
+
+IlluminationSettings Flasher::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	// we toggle every toggle interval, starting "off"
+	const IlluminationSettings * src = ((tick / toggleInterval()) % 2 == 0) ?
+			&base_settings : &curve_target;
+
+	return IlluminationSettings(src->values[vargb_red_idx],
+			src->values[vargb_green_idx],
+			src->values[vargb_blue_idx], 0);
+}
+
+VaRGBTimeValue Flasher::toggleInterval() const
+{
+	VaRGBTimeValue interval = curve_target.transition_ticks / (2 * num_flashes);
+	if (interval < 1)
+	{
+		interval = 1;
+	}
+
+	return interval;
+}
 
 } /* namespace Curve */
 } /* namespace vargb */
@@ -0,0 +1,105 @@
+/*
+
+ Footprint.cpp -- memory used by curves and schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/Footprint.h"
+#include "VaRGBCurves.h"
+
+#ifdef VaRGB_ENABLE_SCHEDULE_BAKING
+#include "includes/Curves/Baked.h"
+#endif
+
+#define footprint_entry(name, type)		{ name, sizeof(type) }
+
+namespace vargb {
+namespace Footprint {
+
+static const Entry curve_types[] = {
+		footprint_entry("Constant", Curve::Constant),
+#ifdef VaRGB_ENABLE_CURVE_LINEAR
+		footprint_entry("Linear", Curve::Linear),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_FLASHER
+		footprint_entry("Flasher", Curve::Flasher),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_SINE
+		footprint_entry("Sine", Curve::Sine),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_ANDLOGIC
+		footprint_entry("AndLogic", Curve::AndLogic),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_ORLOGIC
+		footprint_entry("OrLogic", Curve::OrLogic),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_NOTLOGIC
+		footprint_entry("Not", Curve::Not),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_SHIFTLOGIC
+		footprint_entry("Shift", Curve::Shift),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_THRESHOLDLOGIC
+		footprint_entry("Threshold", Curve::Threshold),
+#endif
+#ifdef VaRGB_ENABLE_CURVE_COMPILEDLOGIC
+		footprint_entry("Compiled", Curve::Compiled),
+#endif
+#ifdef VaRGB_ENABLE_SCHEDULE_BAKING
+		footprint_entry("Baked", Curve::Baked),
+#endif
+};
+
+uint8_t numCurveTypes()
+{
+	return sizeof(curve_types) / sizeof(curve_types[0]);
+}
+
+Entry curveType(uint8_t idx)
+{
+	if (idx >= numCurveTypes())
+	{
+		Entry none = { NULL, 0 };
+		return none;
+	}
+
+	return curve_types[idx];
+}
+
+size_t schedule(const Schedule * sched)
+{
+	return sched ? sched->footprint() : 0;
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+void print(FILE * out, const Schedule * sched)
+{
+	for (uint8_t i = 0; i < numCurveTypes(); i++)
+	{
+		fprintf(out, "%-12s %5u\n", curve_types[i].name, (unsigned)curve_types[i].bytes);
+	}
+
+	if (sched)
+	{
+		fprintf(out, "%-12s %5u\n", "Schedule", (unsigned)schedule(sched));
+	}
+}
+#endif
+
+} /* namespace Footprint */
+} /* namespace vargb */
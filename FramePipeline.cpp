@@ -0,0 +1,109 @@
+/*
+
+ FramePipeline.cpp -- render/output frame handoff between threads, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <stdlib.h>
+#include <string.h>
+#include "includes/FramePipeline.h"
+
+// middle_state: buffer index in the low bits, plus this flag while unread
+#define framepipeline_fresh_flag		0x04
+#define framepipeline_index_mask		0x03
+
+namespace vargb {
+
+FramePipeline::FramePipeline(VaRGBFixtureIndex num_fix) :
+		num_fixtures(num_fix),
+		buffers(NULL),
+		middle_state(1),
+		back_index(0),
+		front_index(2),
+		num_published(0),
+		num_dropped(0),
+		num_late(0)
+{
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		frame_numbers[i] = 0;
+	}
+
+	buffers = (ColorSettings*) VaRGB_MALLOC(sizeof(ColorSettings) * num_fixtures * 3);
+	if (buffers)
+	{
+		memset(buffers, 0, sizeof(ColorSettings) * num_fixtures * 3);
+	}
+}
+
+FramePipeline::~FramePipeline()
+{
+	if (buffers)
+	{
+		VaRGB_FREE(buffers);
+	}
+}
+
+void FramePipeline::publish(const ColorSettings * frame)
+{
+	memcpy(renderBuffer(), frame, sizeof(ColorSettings) * num_fixtures);
+	publish();
+}
+
+void FramePipeline::publish()
+{
+	uint32_t published = num_published + 1;
+	frame_numbers[back_index] = published;
+
+	// release: the frame's contents are visible before the swap is
+	uint8_t previous = __atomic_exchange_n(&middle_state, back_index | framepipeline_fresh_flag,
+			__ATOMIC_ACQ_REL);
+
+	if (previous & framepipeline_fresh_flag)
+	{
+		// the output side never got to see that one
+		__atomic_store_n(&num_dropped, num_dropped + 1, __ATOMIC_RELAXED);
+	}
+
+	back_index = previous & framepipeline_index_mask;
+	__atomic_store_n(&num_published, published, __ATOMIC_RELAXED);
+}
+
+const ColorSettings * FramePipeline::latestFrame()
+{
+	if (! (__atomic_load_n(&middle_state, __ATOMIC_RELAXED) & framepipeline_fresh_flag))
+	{
+		// nothing new: output the same frame again
+		__atomic_store_n(&num_late, num_late + 1, __ATOMIC_RELAXED);
+		return frameBuffer(front_index);
+	}
+
+	// acquire: see everything written to the frame before it was published
+	uint8_t previous = __atomic_exchange_n(&middle_state, front_index, __ATOMIC_ACQ_REL);
+	front_index = previous & framepipeline_index_mask;
+
+	return frameBuffer(front_index);
+}
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
@@ -45,12 +45,12 @@ Linear::~Linear() {
 }
 #endif
 
+#ifdef VaRGB_LINEAR_DDA
+
 void Linear::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
 {
 	DEBUG_OUT2LN("Linear::setTick ", setTo);
 
-	uint16_t num_updates;
-
 	resetCurrentSettings(initial_settings);
 
 	IlluminationTarget start_target(current_settings.values[vargb_red_idx],
@@ -58,17 +58,174 @@ void Linear::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_setting
 			current_settings.values[vargb_blue_idx],
 			0);
 
+	calcDelta(&start_target, &curve_target, &delta);
+
+	// even at tick 0, where we start out is news to our user
+	tick_count = 0;
+	advance(setTo);
+
+	tick_count = setTo;
+	settings_req_update = true;
+
+}
+
+void Linear::tick(VaRGBTimeValue num)
+{
+	advance(num);
 
-	calcDelta(&start_target, &curve_target);
+	tick_count += num;
 
+	if (tick_count >= curve_target.transition_ticks)
+	{
+		curve_completed = true;
+	}
+}
 
-	if (setTo < 1)
+void Linear::advance(VaRGBTimeValue num)
+{
+	// never go past the end of the transition
+	if (tick_count >= delta.period)
 	{
 		return;
 	}
+	if (num > delta.period - tick_count)
+	{
+		num = delta.period - tick_count;
+	}
 
+	for (uint8_t c=0; c< VaRGB_NUM_COLORS; c++)
+	{
+		VaRGBColorValue prev_value = current_settings.values[c];
+
+		if (num == 1)
+		{
+			// the usual case: one add, one compare (written so the error
+			// never goes past the period, which may be near VaRGBTimeValue's max)
+			current_settings.values[c] += delta.increments[c];
+			if (delta.errors[c] >= delta.period - delta.remainders[c])
+			{
+				delta.errors[c] -= delta.period - delta.remainders[c];
+				current_settings.values[c] += delta.steps[c];
+			} else {
+				delta.errors[c] += delta.remainders[c];
+			}
+		} else {
+			VaRGBTimeProduct error_total = ((VaRGBTimeProduct)delta.remainders[c] * num) + delta.errors[c];
+			current_settings.values[c] += (delta.increments[c] * num)
+					+ (delta.steps[c] * (int)(error_total / delta.period));
+			delta.errors[c] = error_total % delta.period;
+		}
+
+		if (current_settings.values[c] != prev_value)
+		{
+			DEBUG_OUTLN("linear color update");
+			settings_req_update = true;
+		}
+	}
+}
+
+VaRGBTimeValue Linear::ticksUntilNextChange()
+{
+	VaRGBTimeValue remaining = ticksRemaining();
+	if (remaining < 1)
+	{
+		return 1;
+	}
+
+	VaRGBTimeValue next_change = remaining;
+	for (uint8_t c=0; c< VaRGB_NUM_COLORS; c++)
+	{
+		if (delta.increments[c] != 0)
+		{
+			// moving on every tick
+			return 1;
+		}
+
+		if (delta.remainders[c])
+		{
+			// ticks until the error accumulator carries over
+			VaRGBTimeValue until_carry = (((VaRGBTimeProduct)delta.period - delta.errors[c]) + delta.remainders[c] - 1)
+					/ delta.remainders[c];
+			if (until_carry < next_change)
+			{
+				next_change = until_carry;
+			}
+		}
+	}
+
+	return next_change;
+}
+
+IlluminationSettings Linear::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	IlluminationDelta at_delta;
+	IlluminationSettings value;
+
+	if (start_settings)
+	{
+		for (uint8_t i=0; i < VaRGB_NUM_COLORS; i++)
+		{
+			value.values[i] = start_settings->values[i];
+		}
+	}
+
+	calcDelta(&value, &curve_target, &at_delta);
+
+	if (tick > at_delta.period)
+	{
+		tick = at_delta.period;
+	}
 
-	// ok, now increment all as required
+	for (uint8_t i=0; i < VaRGB_NUM_COLORS; i++)
+	{
+		value.values[i] += (at_delta.increments[i] * tick)
+				+ (at_delta.steps[i] * (int)(((VaRGBTimeProduct)at_delta.remainders[i] * tick) / at_delta.period));
+	}
+
+	return value;
+}
+
+void Linear::calcDelta(const IlluminationTarget* start_target, const IlluminationTarget* end_target,
+		IlluminationDelta* delta) {
+
+	DEBUG_OUTLN("Linear::calcDelta()");
+
+	// an instantaneous transition jumps to the target on the first tick
+	delta->period = end_target->transition_ticks < 1 ? 1 : end_target->transition_ticks;
+
+	for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++) {
+		int real_delta = end_target->values[i] - start_target->values[i];
+		uint32_t abs_delta = real_delta > 0 ? real_delta : (-1*real_delta);
+
+		delta->steps[i] = real_delta < 0 ? -1 : 1;
+		delta->increments[i] = delta->steps[i] * (int)(abs_delta / delta->period);
+		delta->remainders[i] = abs_delta % delta->period;
+		delta->errors[i] = 0;
+	}
+}
+
+#else
+
+void Linear::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
+{
+	DEBUG_OUT2LN("Linear::setTick ", setTo);
+
+	VaRGBTimeValue num_updates;
+
+	resetCurrentSettings(initial_settings);
+
+	IlluminationTarget start_target(current_settings.values[vargb_red_idx],
+			current_settings.values[vargb_green_idx],
+			current_settings.values[vargb_blue_idx],
+			0);
+
+
+	calcDelta(&start_target, &curve_target, &delta);
+
+
+	// ok, now increment all as required (nothing to do at tick 0, but
+	// where we start out is still news to our user)
 	for (uint8_t i=0; i < VaRGB_NUM_COLORS; i++)
 	{
 #ifdef FLOATIFY_DIVISIONS
@@ -85,38 +242,89 @@ void Linear::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_setting
 
 }
 
-void Linear::tick(uint8_t num)
+void Linear::tick(VaRGBTimeValue num)
 {
+	VaRGBTimeValue new_count = tick_count + num;
 
-
-	for (uint8_t i=0; i<num; i++)
+	for (uint8_t c=0; c< VaRGB_NUM_COLORS; c++)
 	{
-		tick_count++;
-
-		if (tick_count >= curve_target.transition_ticks)
+		if (delta.increments[c] != 0)
 		{
-			curve_completed = true;
+			// number of update points (multiples of the delay) we're moving past
+			VaRGBTimeValue num_updates = (new_count / delta.delays[c]) - (tick_count / delta.delays[c]);
+			if (num_updates)
+			{
+				DEBUG_OUTLN("linear color update");
+				current_settings.values[c] += num_updates * delta.increments[c];
+				settings_req_update = true;
+			}
 		}
+	}
+
+	tick_count = new_count;
+
+	if (tick_count >= curve_target.transition_ticks)
+	{
+		curve_completed = true;
+	}
+}
+
+VaRGBTimeValue Linear::ticksUntilNextChange()
+{
+	VaRGBTimeValue remaining = ticksRemaining();
+	if (remaining < 1)
+	{
+		return 1;
+	}
 
-		for (uint8_t c=0; c< VaRGB_NUM_COLORS; c++)
+	VaRGBTimeValue next_change = remaining;
+	for (uint8_t c=0; c< VaRGB_NUM_COLORS; c++)
+	{
+		if (delta.increments[c] != 0)
 		{
-			if (delta.increments[c] != 0)
+			// ticks until the next multiple of the delay
+			VaRGBTimeValue until_update = delta.delays[c] - (tick_count % delta.delays[c]);
+			if (until_update < next_change)
 			{
-				if (delta.delays[c]==1 || (tick_count % delta.delays[c]) == 0)
-				{
-
-					DEBUG_OUTLN("linear color update");
-					current_settings.values[c] += delta.increments[c];
-					settings_req_update = true;
-				}
+				next_change = until_update;
 			}
 		}
+	}
+
+	return next_change;
+}
 
+IlluminationSettings Linear::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	IlluminationDelta at_delta;
+	IlluminationSettings value;
+
+	if (start_settings)
+	{
+		for (uint8_t i=0; i < VaRGB_NUM_COLORS; i++)
+		{
+			value.values[i] = start_settings->values[i];
+		}
+	}
+
+	calcDelta(&value, &curve_target, &at_delta);
+
+	// each channel moves by its increment every delays[] ticks
+	for (uint8_t i=0; i < VaRGB_NUM_COLORS; i++)
+	{
+		if (at_delta.increments[i] != 0)
+		{
+			value.values[i] += (tick / at_delta.delays[i]) * at_delta.increments[i];
+		}
 	}
+
+	return value;
 }
 
 
-void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end_target) {
+void Linear::calcDelta(const IlluminationTarget* start_target, const IlluminationTarget* end_target,
+		IlluminationDelta* delta) {
 	int real_delta;
 	VaRGBColorValue test_delta_per_unittime;
 	VaRGBColorValue test_result;
@@ -126,7 +334,7 @@ void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end
 	VaRGBTimeValue best_unittime;
 	VaRGBColorValue best_error;
 	VaRGBColorValue cur_error;
-	uint16_t numslices;
+	VaRGBTimeValue numslices;
 
 	DEBUG_OUTLN("Linear::calcDelta()");
 
@@ -140,9 +348,9 @@ void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end
 		if (real_delta == 0) {
 			DEBUG_OUT2LN("No change for color ", i);
 			// no change for this color... set a sane update time/amount and skip it.
-			delta.delays[i] =
+			delta->delays[i] =
 					VaRGB_SECONDS_TO_UNITTIME(VaRGB_MAXIMUM_UPDATE_DELAY_SECONDS);
-			delta.increments[i] = 0;
+			delta->increments[i] = 0;
 			continue;
 		}
 
@@ -153,6 +361,14 @@ void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end
 
 		abs_delta = real_delta > 0 ? real_delta : (-1*real_delta);
 
+		if (end_target->transition_ticks < 1)
+		{
+			// instantaneous transition: jump to the target on the first tick
+			delta->delays[i] = 1;
+			delta->increments[i] = real_delta;
+			continue;
+		}
+
 
 
 		if (abs_delta >= end_target->transition_ticks)
@@ -183,7 +399,7 @@ void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end
 			// per unit?
 
 #ifdef FLOATIFY_DIVISIONS
-			uint16_t numslices = floor(
+			VaRGBTimeValue numslices = floor(
 					(1.0 * end_target->transition_ticks)
 							/ (1.0 * test_unittime));
 
@@ -218,33 +434,36 @@ void Linear::calcDelta(IlluminationTarget* start_target, IlluminationTarget* end
 			test_unittime++;
 		}
 		// now, we should have a decent value for our increment
-		delta.delays[i] = best_unittime;
+		delta->delays[i] = best_unittime;
 
 #ifdef FLOATIFY_DIVISIONS
 
 		numslices = (1.0 * end_target->transition_ticks)/(1.0 * best_unittime);
-		delta.increments[i] = floor((1.0 * abs_delta)/ (1.0 * numslices);
+		delta->increments[i] = floor((1.0 * abs_delta)/ (1.0 * numslices);
 #else
 
 
 		numslices = end_target->transition_ticks/best_unittime;
-		delta.increments[i] = (abs_delta/numslices);
+		delta->increments[i] = (abs_delta/numslices);
 #endif
 		if (real_delta < 0)
 		{
-			delta.increments[i] *= -1;
+			delta->increments[i] *= -1;
 		}
 
 		DEBUG_OUTLN("Linear delta calc done");
 		DEBUG_OUT("increment: ");
-		DEBUG_OUT(delta.increments[i]);
+		DEBUG_OUT(delta->increments[i]);
 		DEBUG_OUT(" every (ticks):");
-		DEBUG_OUTLN(delta.delays[i]);
+		DEBUG_OUTLN(delta->delays[i]);
 
 
 	}
 }
 
+// VaRGB_LINEAR_DDA
+#endif
+
 } /* namespace Curve */
 } /* namespace vargb */
 
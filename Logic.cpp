@@ -29,80 +29,226 @@
 namespace vargb {
 namespace Curve {
 
-Dummy Logic::dummy_curve;
+uint64_t Logic::frames_started = 0;
+VaRGB_THREAD_LOCAL uint64_t Logic::current_frame = 0;
+VaRGB_THREAD_LOCAL uint8_t Logic::tick_depth = 0;
 
 Logic::Logic(vargb::Curve::Curve* curve_a,
 		vargb::Curve::Curve* curve_b) :
 		vargb::Curve::Curve(0,0,0,0)
 {
-	curves[0] = curve_a;
-	if (curve_b == NULL)
+	vargb::Curve::Curve * children[2] = {curve_a, curve_b};
+
+	setChildren(children, curve_b ? 2 : 1);
+}
+
+Logic::Logic(vargb::Curve::Curve* children[], uint8_t num) :
+		vargb::Curve::Curve(0,0,0,0)
+{
+	setChildren(children, num);
+}
+
+bool Logic::setChildren(vargb::Curve::Curve* children[], uint8_t num)
+{
+	num_curves = 0;
+	curve_target.transition_ticks = 0;
+
+	if (num < 1 || num > VARGB_CURVE_LOGIC_NUMCURVES)
 	{
-		curves[1] = &dummy_curve;
-	} else {
-		curves[1] = curve_b;
+		// nothing to combine, or more than we've room for: leave
+		// ourselves childless, which valid() reports
+		return false;
+	}
+
+	for (uint8_t i = 0; i < num; i++) {
+		if (! children[i])
+		{
+			return false;
+		}
+	}
+
+	num_curves = num;
+	for (uint8_t i = 0; i < num_curves; i++) {
+		curves[i] = children[i];
+	}
+
+	// we run until the first child completes, so that's
+	// our length as far as schedules are concerned.
+	curve_target.transition_ticks = curves[0]->target()->transition_ticks;
+	for (uint8_t i = 1; i < num_curves; i++) {
+		if (curves[i]->target()->transition_ticks < curve_target.transition_ticks)
+		{
+			curve_target.transition_ticks = curves[i]->target()->transition_ticks;
+		}
 	}
+
+	return true;
 }
+
 bool Logic::completed()
 {
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
+	for (uint8_t i = 0; i < num_curves; i++) {
 		if (curves[i]->completed())
 		{
 			return true;
 		}
 	}
 
-	return false;
+	// without children (see valid()), we're done before we start
+	return ! num_curves;
 }
+
+VaRGBTimeValue Logic::ticksRemaining()
+{
+	if (! num_curves)
+	{
+		return 0;
+	}
+
+	// we complete as soon as any child does
+	VaRGBTimeValue remaining = VaRGB_TIMEVALUE_MAX;
+	for (uint8_t i = 0; i < num_curves; i++) {
+		VaRGBTimeValue child_remaining = curves[i]->ticksRemaining();
+		if (child_remaining < remaining)
+		{
+			remaining = child_remaining;
+		}
+	}
+
+	return remaining;
+}
+
+VaRGBTimeValue Logic::ticksUntilNextChange()
+{
+	// our output may change whenever any child's does
+	VaRGBTimeValue next_change = VaRGB_TIMEVALUE_MAX;
+	for (uint8_t i = 0; i < num_curves; i++) {
+		VaRGBTimeValue child_next = curves[i]->ticksUntilNextChange();
+		if (child_next < next_change)
+		{
+			next_change = child_next;
+		}
+	}
+
+	return next_change;
+}
+
 void Logic::settingsUpdated() {
 
 	settings_req_update = false;
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
+	for (uint8_t i = 0; i < num_curves; i++) {
 		curves[i]->settingsUpdated();
 	}
 }
 
 void Logic::start(IlluminationSettings* initial_settings) {
 
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
+	for (uint8_t i = 0; i < num_curves; i++) {
 		curves[i]->start(initial_settings);
+		curves[i]->tick_frame = 0;
 	}
+
+	// combine right away, so our settings reflect the children from the start
+	this->childUpdated();
+	settings_req_update = true;
 }
 
 void Logic::setTick(VaRGBTimeValue setTo,
 		IlluminationSettings* initial_settings) {
 
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
+	for (uint8_t i = 0; i < num_curves; i++) {
 		curves[i]->setTick(setTo, initial_settings);
+		curves[i]->tick_frame = 0;
+	}
+
+	// whatever the children had before is irrelevant now
+	this->childUpdated();
+	settings_req_update = true;
+}
+
+void Logic::tick(VaRGBTimeValue num) {
+
+	// a tick that doesn't come from another Logic starts a new frame.
+	// Frame 0 is never used, as that's where every curve starts out (and
+	// where start() and setTick() put them back).  Frames are numbered
+	// process-wide, as the same curves may be ticked by a different thread
+	// each frame (see ParallelGroup): a per-thread count could come up with
+	// a number a child was already stamped with.
+	if (! tick_depth) {
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+		current_frame = __atomic_add_fetch(&frames_started, 1, __ATOMIC_RELAXED);
+#else
+		current_frame = ++frames_started;
+#endif
+	}
+
+	tick_depth++;
+	for (uint8_t i = 0; i < num_curves; i++) {
+		// children shared with some other parent may already
+		// have been ticked this frame
+		if (curves[i]->tick_frame != current_frame) {
+			curves[i]->tick_frame = current_frame;
+			curves[i]->tick(num);
+		}
 		if (curves[i]->settingsNeedUpdate()) {
 			settings_req_update = true;
 		}
 
 	}
+	tick_depth--;
 
 	if (settings_req_update) {
 		this->childUpdated();
 	}
 }
 
-void Logic::tick(uint8_t num) {
+void Logic::childUpdated() {
 
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
-		curves[i]->tick(num);
-		if (curves[i]->settingsNeedUpdate()) {
-			settings_req_update = true;
-		}
+	const IlluminationSettings * child_settings[VARGB_CURVE_LOGIC_NUMCURVES];
 
+	if (! num_curves)
+	{
+		// nothing to combine (combine() expects at least one child)
+		return;
 	}
 
-	if (settings_req_update) {
-		this->childUpdated();
+	for (uint8_t i = 0; i < num_curves; i++) {
+		child_settings[i] = curves[i]->currentSettings();
+	}
+
+	combine(child_settings, &current_settings);
+}
+
+IlluminationSettings Logic::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const {
+
+	IlluminationSettings child_values[VARGB_CURVE_LOGIC_NUMCURVES];
+	const IlluminationSettings * child_settings[VARGB_CURVE_LOGIC_NUMCURVES];
+	IlluminationSettings value;
+
+	if (! num_curves)
+	{
+		return value;
+	}
+
+	for (uint8_t i = 0; i < num_curves; i++) {
+		child_values[i] = curves[i]->valueAt(tick, start_settings);
+		child_settings[i] = &(child_values[i]);
 	}
+
+	combine(child_settings, &value);
+
+	return value;
+}
+
+void Logic::describe(LogicInstruction * into) const {
+	into->opcode = LogicOpCustom;
+	into->node = this;
 }
 
 void Logic::reset() {
 
-	for (uint8_t i = 0; i < VARGB_CURVE_LOGIC_NUMCURVES; i++) {
+	for (uint8_t i = 0; i < num_curves; i++) {
 		curves[i]->reset();
 	}
 }
@@ -25,7 +25,6 @@
 #ifdef VaRGB_ENABLE_CURVE_NOTLOGIC
 
 #include "includes/Curves/Not.h"
-#include "includes/Curves/Dummy.h"
 #ifndef VaRGB_ENABLE_CURVE_LOGICAL
 #error "VaRGB_ENABLE_CURVE_NOTLOGIC defined but not VaRGB_ENABLE_CURVE_LOGICAL (see config)"
 #endif
@@ -47,7 +46,8 @@ Not::Not(vargb::Curve::Curve * curve, bool red_channel, bool green_channel, bool
 	channel_on[channel_idx_blue] = blue_channel;
 }
 
-void Not::childUpdated()
+void Not::combine(const IlluminationSettings * child_settings[],
+		IlluminationSettings * into) const
 {
 
 	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
@@ -55,14 +55,28 @@ void Not::childUpdated()
 		if (channel_on[i])
 		{
 			// need to apply the NOT
-			current_settings.values[i] = VaRGB_COLOR_MAXVALUE & (~(curves[0]->currentSettings()->values[i]));
+			into->values[i] = VaRGB_COLOR_MAXVALUE & (~(child_settings[0]->values[i]));
 		} else {
-			current_settings.values[i] = curves[0]->currentSettings()->values[i];
+			into->values[i] = child_settings[0]->values[i];
 		}
 	}
 
 
 }
+
+void Not::describe(LogicInstruction * into) const
+{
+	into->opcode = LogicOpNot;
+	into->channels = 0;
+	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
+	{
+		if (channel_on[i])
+		{
+			into->channels |= (1 << i);
+		}
+	}
+}
+
 } /* namespace Curve */
 } /* namespace vargb */
 
@@ -38,14 +38,23 @@ OrLogic::OrLogic(vargb::Curve::Curve * curve_a,
 
 }
 
-void OrLogic::childUpdated()
+OrLogic::OrLogic(vargb::Curve::Curve * curves[], uint8_t num)
+: Logic(curves, num)
+{
+
+}
+
+void OrLogic::combine(const IlluminationSettings * child_settings[],
+		IlluminationSettings * into) const
 {
 
 	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
 	{
-		current_settings.values[i] =
-				curves[0]->currentSettings()->values[i] |
-				curves[1]->currentSettings()->values[i];
+		into->values[i] = child_settings[0]->values[i];
+		for (uint8_t c=1; c<num_curves; c++)
+		{
+			into->values[i] |= child_settings[c]->values[i];
+		}
 
 		/*
 		Serial.print(i, DEC);
@@ -62,6 +71,12 @@ void OrLogic::childUpdated()
 
 
 }
+
+void OrLogic::describe(LogicInstruction * into) const
+{
+	into->opcode = LogicOpOr;
+}
+
 } /* namespace Curve */
 } /* namespace vargb */
 
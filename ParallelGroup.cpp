@@ -0,0 +1,487 @@
+/*
+
+ ParallelGroup.cpp -- drivers ticked by several threads, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "includes/ParallelGroup.h"
+
+#define parallelgroup_partition_of(idx)		((idx) / VaRGB_PARALLELGROUP_PARTITION_SIZE)
+#define parallelgroup_index_within(idx)		((idx) % VaRGB_PARALLELGROUP_PARTITION_SIZE)
+
+// takePartition()/stealPartition() results, when they have no partition to give
+#define parallelgroup_no_task					-1
+#define parallelgroup_lost_race				-2
+
+namespace vargb {
+
+ParallelGroup::ParallelGroup(VaRGBFixtureIndex max_num_drivers, uint8_t num_threads_requested,
+		DriverGroup_Frame_Callback frame_callback) :
+		max_drivers(max_num_drivers),
+		num_drivers(0),
+		num_threads(num_threads_requested),
+		num_partitions(0),
+		is_valid(false),
+		frame_cb(frame_callback),
+		frame_buffer(NULL),
+		dirty_bits(NULL),
+		partitions(NULL),
+		partition_stride(0),
+		threads(NULL),
+		thread_tasks(NULL),
+		launched(false),
+		pending_ticks(0),
+		stopping(false)
+{
+	pthread_mutex_init(&launch_lock, NULL);
+	pthread_cond_init(&launch_cond, NULL);
+
+	uint16_t partitions_needed = (max_drivers + VaRGB_PARALLELGROUP_PARTITION_SIZE - 1)
+			/ VaRGB_PARALLELGROUP_PARTITION_SIZE;
+	if (! partitions_needed)
+	{
+		return;
+	}
+
+	// no use having threads with nothing to do
+	if (num_threads < 1)
+	{
+		num_threads = 1;
+	}
+	if (num_threads > partitions_needed)
+	{
+		num_threads = partitions_needed;
+	}
+
+	// the frame and dirty bits, sized in whole partitions so every
+	// slice starts and ends on a cache line boundary (at the default
+	// partition size)
+	size_t frame_size = sizeof(ColorSettings) * VaRGB_PARALLELGROUP_PARTITION_SIZE * partitions_needed;
+	size_t dirty_size = (VaRGB_PARALLELGROUP_PARTITION_SIZE / 8) * partitions_needed;
+	if (VaRGB_MEMALIGN((void**)&frame_buffer, VaRGB_CACHE_LINE_SIZE, frame_size)
+			|| VaRGB_MEMALIGN((void**)&dirty_bits, VaRGB_CACHE_LINE_SIZE, dirty_size))
+	{
+		return;
+	}
+	memset(frame_buffer, 0, frame_size);
+	memset(dirty_bits, 0, dirty_size);
+
+	// the partitions' DriverGroups themselves, a cache line apart
+	partition_stride = ((sizeof(DriverGroup) + VaRGB_CACHE_LINE_SIZE - 1) / VaRGB_CACHE_LINE_SIZE)
+			* VaRGB_CACHE_LINE_SIZE;
+	if (VaRGB_MEMALIGN((void**)&partitions, VaRGB_CACHE_LINE_SIZE, partition_stride * partitions_needed))
+	{
+		partitions = NULL;
+		return;
+	}
+
+	for (uint16_t p = 0; p < partitions_needed; p++)
+	{
+		VaRGBFixtureIndex first = p * VaRGB_PARALLELGROUP_PARTITION_SIZE;
+		VaRGBFixtureIndex size = (max_drivers - first) < VaRGB_PARALLELGROUP_PARTITION_SIZE ?
+				(max_drivers - first) : VaRGB_PARALLELGROUP_PARTITION_SIZE;
+
+		new (partition(p)) DriverGroup(size, &(frame_buffer[first]),
+				&(dirty_bits[first / 8]));
+		num_partitions++;
+
+		if (! partition(p)->valid())
+		{
+			return;
+		}
+	}
+
+	// room for each thread's deque, should it get every partition
+	size_t tasks_stride = ((sizeof(uint16_t) * partitions_needed + VaRGB_CACHE_LINE_SIZE - 1)
+			/ VaRGB_CACHE_LINE_SIZE) * VaRGB_CACHE_LINE_SIZE;
+	if (VaRGB_MEMALIGN((void**)&thread_tasks, VaRGB_CACHE_LINE_SIZE, tasks_stride * num_threads))
+	{
+		thread_tasks = NULL;
+		return;
+	}
+
+	// thread state, with the barriers they meet at on every frame
+	if (pthread_barrier_init(&frame_start, NULL, num_threads))
+	{
+		return;
+	}
+	if (pthread_barrier_init(&frame_done, NULL, num_threads))
+	{
+		pthread_barrier_destroy(&frame_start);
+		return;
+	}
+
+	if (VaRGB_MEMALIGN((void**)&threads, VaRGB_CACHE_LINE_SIZE, sizeof(ParallelGroupThread) * num_threads))
+	{
+		threads = NULL;
+		pthread_barrier_destroy(&frame_start);
+		pthread_barrier_destroy(&frame_done);
+		return;
+	}
+
+	for (uint8_t t = 0; t < num_threads; t++)
+	{
+		threads[t].group = this;
+		threads[t].index = t;
+		threads[t].started = false;
+		threads[t].num_touched = 0;
+		threads[t].num_stolen = 0;
+		threads[t].tasks = (uint16_t*)((uint8_t*)thread_tasks + t * tasks_stride);
+		threads[t].top = 0;
+		threads[t].bottom = 0;
+	}
+
+	// threads[0] is whoever calls tick(), start the others
+	for (uint8_t t = 1; t < num_threads; t++)
+	{
+		if (pthread_create(&(threads[t].thread), NULL, threadMain, &(threads[t])))
+		{
+			// couldn't get them all: send those we have home
+			stopping = true;
+			break;
+		}
+		threads[t].started = true;
+	}
+
+	launch();
+
+	if (stopping)
+	{
+		stopThreads();
+		return;
+	}
+
+	is_valid = true;
+}
+
+ParallelGroup::~ParallelGroup()
+{
+	if (threads)
+	{
+		stopThreads();
+		pthread_barrier_destroy(&frame_start);
+		pthread_barrier_destroy(&frame_done);
+		VaRGB_FREE(threads);
+	}
+
+	if (thread_tasks)
+	{
+		VaRGB_FREE(thread_tasks);
+	}
+
+	if (partitions)
+	{
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+		for (uint16_t p = 0; p < num_partitions; p++)
+		{
+			partition(p)->~DriverGroup();
+		}
+#endif
+		VaRGB_FREE(partitions);
+	}
+
+	if (frame_buffer)
+	{
+		VaRGB_FREE(frame_buffer);
+	}
+	if (dirty_bits)
+	{
+		VaRGB_FREE(dirty_bits);
+	}
+
+	pthread_mutex_destroy(&launch_lock);
+	pthread_cond_destroy(&launch_cond);
+}
+
+void ParallelGroup::launch()
+{
+	pthread_mutex_lock(&launch_lock);
+	launched = true;
+	pthread_cond_broadcast(&launch_cond);
+	pthread_mutex_unlock(&launch_lock);
+}
+
+void ParallelGroup::stopThreads()
+{
+	if (is_valid && num_threads > 1)
+	{
+		// the threads are all waiting for the next frame: give them this one instead
+		stopping = true;
+		pthread_barrier_wait(&frame_start);
+	}
+	is_valid = false;
+
+	for (uint8_t t = 1; t < num_threads; t++)
+	{
+		if (threads[t].started)
+		{
+			pthread_join(threads[t].thread, NULL);
+			threads[t].started = false;
+		}
+	}
+}
+
+void * ParallelGroup::threadMain(void * thread_state)
+{
+	ParallelGroupThread * thread = (ParallelGroupThread*) thread_state;
+	ParallelGroup * group = thread->group;
+
+	pthread_mutex_lock(&(group->launch_lock));
+	while (! group->launched)
+	{
+		pthread_cond_wait(&(group->launch_cond), &(group->launch_lock));
+	}
+	pthread_mutex_unlock(&(group->launch_lock));
+
+	if (group->stopping)
+	{
+		return NULL;
+	}
+
+	while (true)
+	{
+		// pending_ticks and stopping are set before the frame starts
+		pthread_barrier_wait(&(group->frame_start));
+		if (group->stopping)
+		{
+			break;
+		}
+
+		group->tickPartitions(thread);
+
+		pthread_barrier_wait(&(group->frame_done));
+	}
+
+	return NULL;
+}
+
+void ParallelGroup::dealPartitions()
+{
+	// only ever called between frames, while no one else is looking
+	for (uint8_t t = 0; t < num_threads; t++)
+	{
+		threads[t].top = 0;
+		threads[t].bottom = 0;
+		threads[t].num_stolen = 0;
+	}
+
+	// every partition ticks, even while empty, so they all agree on the time
+	for (uint16_t p = 0; p < num_partitions; p++)
+	{
+		ParallelGroupThread * thread = &(threads[p % num_threads]);
+		thread->tasks[thread->bottom++] = p;
+	}
+}
+
+int16_t ParallelGroup::takePartition(ParallelGroupThread * thread)
+{
+	// claim the bottom task, then make sure no thief got there first
+	int32_t bottom = thread->bottom - 1;
+	__atomic_store_n(&(thread->bottom), bottom, __ATOMIC_SEQ_CST);
+	int32_t top = __atomic_load_n(&(thread->top), __ATOMIC_SEQ_CST);
+
+	if (top > bottom)
+	{
+		// already empty
+		__atomic_store_n(&(thread->bottom), bottom + 1, __ATOMIC_RELAXED);
+		return parallelgroup_no_task;
+	}
+
+	int16_t task = thread->tasks[bottom];
+	if (top == bottom)
+	{
+		// the last one: thieves may be after it too
+		if (! __atomic_compare_exchange_n(&(thread->top), &top, top + 1, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		{
+			task = parallelgroup_no_task;
+		}
+		__atomic_store_n(&(thread->bottom), bottom + 1, __ATOMIC_RELAXED);
+	}
+
+	return task;
+}
+
+int16_t ParallelGroup::stealPartition(ParallelGroupThread * victim)
+{
+	int32_t top = __atomic_load_n(&(victim->top), __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	int32_t bottom = __atomic_load_n(&(victim->bottom), __ATOMIC_ACQUIRE);
+
+	if (top >= bottom)
+	{
+		return parallelgroup_no_task;
+	}
+
+	int16_t task = victim->tasks[top];
+	if (! __atomic_compare_exchange_n(&(victim->top), &top, top + 1, false,
+			__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+	{
+		// the owner, or another thief, took it
+		return parallelgroup_lost_race;
+	}
+
+	return task;
+}
+
+void ParallelGroup::tickPartitions(ParallelGroupThread * thread)
+{
+	int16_t p;
+	thread->num_touched = 0;
+
+	while ((p = takePartition(thread)) != parallelgroup_no_task)
+	{
+		partition(p)->tick(pending_ticks);
+		thread->num_touched += partition(p)->numTouched();
+	}
+
+	// nothing is added to the deques during a frame, so once a
+	// deque comes up empty, it stays that way: one round will do.
+	for (uint8_t i = 1; i < num_threads; i++)
+	{
+		ParallelGroupThread * victim = &(threads[(thread->index + i) % num_threads]);
+		while ((p = stealPartition(victim)) != parallelgroup_no_task)
+		{
+			if (p == parallelgroup_lost_race)
+			{
+				continue;
+			}
+			partition(p)->tick(pending_ticks);
+			thread->num_touched += partition(p)->numTouched();
+			thread->num_stolen++;
+		}
+	}
+}
+
+VaRGBFixtureIndex ParallelGroup::add(VaRGB * driver)
+{
+	if (! is_valid || num_drivers >= max_drivers)
+	{
+		return VaRGB_DRIVERGROUP_INVALID_INDEX;
+	}
+
+	if (partition(parallelgroup_partition_of(num_drivers))->add(driver)
+			== VaRGB_DRIVERGROUP_INVALID_INDEX)
+	{
+		return VaRGB_DRIVERGROUP_INVALID_INDEX;
+	}
+
+	return num_drivers++;
+}
+
+VaRGB * ParallelGroup::driver(VaRGBFixtureIndex idx)
+{
+	return partition(parallelgroup_partition_of(idx))->driver(parallelgroup_index_within(idx));
+}
+
+void ParallelGroup::reschedule(VaRGBFixtureIndex idx)
+{
+	if (idx >= num_drivers)
+	{
+		return;
+	}
+
+	partition(parallelgroup_partition_of(idx))->reschedule(parallelgroup_index_within(idx));
+}
+
+void ParallelGroup::sync()
+{
+	for (uint16_t p = 0; p < num_partitions; p++)
+	{
+		partition(p)->sync();
+	}
+}
+
+void ParallelGroup::tick(VaRGBTimeValue num)
+{
+	if (! is_valid)
+	{
+		return;
+	}
+
+	pending_ticks = num;
+	dealPartitions();
+	if (num_threads > 1)
+	{
+		pthread_barrier_wait(&frame_start);
+	}
+
+	tickPartitions(&(threads[0]));
+
+	if (num_threads > 1)
+	{
+		pthread_barrier_wait(&frame_done);
+	}
+
+	if (frame_cb)
+	{
+		frame_cb(frame_buffer, dirty_bits, num_drivers);
+	}
+	memset(dirty_bits, 0, (num_drivers + 7) / 8);
+}
+
+VaRGBFixtureIndex ParallelGroup::numTouched()
+{
+	VaRGBFixtureIndex total = 0;
+	for (uint8_t t = 0; t < num_threads; t++)
+	{
+		total += threads[t].num_touched;
+	}
+
+	return total;
+}
+
+uint16_t ParallelGroup::numStolen()
+{
+	uint16_t total = 0;
+	for (uint8_t t = 0; t < num_threads; t++)
+	{
+		total += threads[t].num_stolen;
+	}
+
+	return total;
+}
+
+void ParallelGroup::tickAndDelay(VaRGBTimeValue num)
+{
+	tick(num);
+	vargb::delayMs(num * VaRGB::tickDelayTimeMs());
+}
+
+void ParallelGroup::tickAndWait(TickClock * clock)
+{
+	VaRGBTickCount elapsed = clock->waitForTicks();
+
+	while (elapsed > 0)
+	{
+		VaRGBTimeValue num = elapsed > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : elapsed;
+		tick(num);
+		elapsed -= num;
+	}
+}
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
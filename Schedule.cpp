@@ -30,8 +30,11 @@ namespace vargb {
 ScheduleID Schedule::schedule_counter = 0;
 Schedule::Schedule(ScheduleID id) :
 		sched_id(id),
-		transition_ptr_list(NULL), transition_index(0),
-		transition_num(0), total_schedule_ticks(0),
+		transition_ptr_list(NULL), transition_start_ticks(NULL),
+		transition_index(0), transition_num(0), transition_max(0),
+		total_schedule_ticks(0),
+		run_completed(false),
+		fixed_list(false),
 		driver(NULL)
 {
 
@@ -48,11 +51,54 @@ Schedule::Schedule(ScheduleID id) :
 
 }
 
+Schedule::Schedule(Arena * arena, uint16_t max_transitions, ScheduleID id) :
+		sched_id(id),
+		transition_ptr_list(NULL), transition_start_ticks(NULL),
+		transition_index(0), transition_num(0), transition_max(0),
+		total_schedule_ticks(0),
+		run_completed(false),
+		fixed_list(true),
+		driver(NULL)
+{
+
+	if (sched_id == 0)
+	{
+		sched_id = schedule_counter;
+	} else {
+		schedule_counter = sched_id > schedule_counter ? sched_id: schedule_counter;
+	}
+
+	schedule_counter++;
+
+	transition_start_ticks = (VaRGBTimeValue*) arena->allocate(sizeof(VaRGBTimeValue) * max_transitions);
+	if (transition_start_ticks)
+	{
+		// list last, as valid() depends on it
+		transition_ptr_list = (vargb::Curve::Curve**) arena->allocate(
+				sizeof(vargb::Curve::Curve *) * max_transitions);
+	}
+
+	if (transition_ptr_list)
+	{
+		memset(transition_ptr_list, 0, sizeof(vargb::Curve::Curve *) * max_transitions);
+		transition_max = max_transitions;
+	}
+
+}
+
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
 Schedule::~Schedule() {
 
+	if (fixed_list) {
+		// the arena takes care of it
+		return;
+	}
+
 	if (transition_ptr_list) {
-		free(transition_ptr_list);
+		VaRGB_FREE(transition_ptr_list);
+	}
+	if (transition_start_ticks) {
+		VaRGB_FREE(transition_start_ticks);
 	}
 }
 #endif
@@ -66,35 +112,72 @@ bool Schedule::addTransition(vargb::Curve::Curve * a_curv) {
 	}
 
 	transition_ptr_list[transition_num] = a_curv;
+	transition_start_ticks[transition_num] = total_schedule_ticks;
 
-	total_schedule_ticks += (a_curv->target())->transition_ticks;
+	// as run by tick(), every transition lasts at least one tick (which
+	// is what it takes to complete)
+	VaRGBTimeValue num_ticks = (a_curv->target())->transition_ticks;
+	total_schedule_ticks += num_ticks ? num_ticks : 1;
 
 	transition_num++;
 
 	return true;
+}
+
+bool Schedule::reserve(uint16_t num_transitions) {
+	if (num_transitions <= transition_max) {
+		return true;
+	}
+
+	return expandTransitionList(num_transitions - transition_max);
+
+}
+
+size_t Schedule::footprint() const {
+	return sizeof(Schedule)
+			+ transition_max * (sizeof(vargb::Curve::Curve *) + sizeof(VaRGBTimeValue));
+}
 
+uint16_t Schedule::transitionIndexAt(VaRGBTimeValue tick_position) const {
+
+	// find the first transition starting at or after tick_position...
+	uint16_t low = 0;
+	uint16_t high = transition_num;
+	while (low < high) {
+		uint16_t mid = low + ((high - low) / 2);
+		if (transition_start_ticks[mid] < tick_position) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low < transition_num && transition_start_ticks[low] == tick_position) {
+		// right at its start
+		return low;
+	}
+
+	// otherwise, we're part-way through the one before it
+	return low - 1;
 }
 
 void Schedule::setTick(VaRGBTimeValue tick_count) {
-	VaRGBTimeValue ticks_for_transition;
-	VaRGBTimeValue tick_position = tick_count % total_schedule_ticks;
-	VaRGBTimeValue tick_remainder = 0;
+	VaRGBTimeValue tick_position = 0;
 
 	DEBUG_OUT2LN("Schedule::setTick ", tick_count);
-	transition_index = 0;
-
-	while (tick_position > 0) {
-			ticks_for_transition =
-					(transition_ptr_list[transition_index]->target())->transition_ticks;
-			if (tick_position >= ticks_for_transition) {
-				tick_position -= ticks_for_transition;
-				transition_index++;
-			} else {
-				tick_remainder = tick_position;
-				tick_position = 0;
-			}
 
-		}
+	run_completed = false;
+
+	if (transition_num < 1) {
+		return;
+	}
+
+	if (total_schedule_ticks) {
+		tick_position = tick_count % total_schedule_ticks;
+	}
+
+	transition_index = transitionIndexAt(tick_position);
+	VaRGBTimeValue tick_remainder = tick_position - transition_start_ticks[transition_index];
 
 	// found the transition (curve) we are in
 	IlluminationSettings * last_target_settings = NULL;
@@ -115,34 +198,96 @@ void Schedule::setTick(VaRGBTimeValue tick_count) {
 
 }
 
-void Schedule::tick(uint8_t num) {
+IlluminationSettings Schedule::valueAt(VaRGBTimeValue tick_count) const {
+	VaRGBTimeValue tick_position = 0;
 
+	if (transition_num < 1) {
+		return IlluminationSettings();
+	}
 
+	if (total_schedule_ticks) {
+		tick_position = tick_count % total_schedule_ticks;
+	}
 
-	transition_ptr_list[transition_index]->tick(num);
+	// same positioning as setTick()
+	uint16_t idx = transitionIndexAt(tick_position);
+	const IlluminationSettings * last_target_settings = NULL;
+	if (idx > 0) {
+		last_target_settings = transition_ptr_list[idx - 1]->target();
+	}
 
-	if (transition_ptr_list[transition_index]->settingsNeedUpdate()) {
-		// DEBUG_OUTLN("setting need update");
-		sendCurTransitionSettings();
+	return transition_ptr_list[idx]->valueAt(
+			tick_position - transition_start_ticks[idx], last_target_settings);
+}
+
+VaRGBTimeValue Schedule::tick(VaRGBTimeValue num) {
+
+	run_completed = false;
+
+	if (transition_num < 1) {
+		return 0;
 	}
 
-	if (transition_ptr_list[transition_index]->completed()) {
+	while (num) {
+		vargb::Curve::Curve * cur_transition = transition_ptr_list[transition_index];
 
-		IlluminationTarget * last_target = transition_ptr_list[transition_index]->target();
-		DEBUG_OUTLN("transition complete");
-		transition_index++;
-		if (transition_index >= transition_num) {
+		// go as far as we can within this transition (always
+		// at least one tick, which is what it'd take to complete)
+		VaRGBTimeValue step = cur_transition->ticksRemaining();
+		if (step > num) {
+			step = num;
+		} else if (step < 1) {
+			step = 1;
+		}
 
-			DEBUG_OUTLN("all transitions done (schedule complete)");
-			transition_index = 0;
-			driver->scheduleComplete(this);
+		cur_transition->tick(step);
+		num -= step;
+
+		if (cur_transition->settingsNeedUpdate()) {
+			// DEBUG_OUTLN("setting need update");
+			sendCurTransitionSettings();
+		}
+
+		if (cur_transition->completed()) {
+
+			IlluminationTarget * last_target = cur_transition->target();
+			DEBUG_OUTLN("transition complete");
+			transition_index++;
+			if (transition_index >= transition_num) {
+
+				DEBUG_OUTLN("all transitions done (schedule complete)");
+				// the driver restarts us with setTick(0), so every run starts
+				// out just like valueAt(0)--unless its callback moves on to
+				// some other schedule.
+				transition_index = 0;
+				run_completed = true;
+
+				// let the driver deal with it before going any further
+				return num;
+
+			}
 
-		} else {
 			// we move on to the next transition...
 			transition_ptr_list[transition_index]->start(last_target);
 		}
 	}
+
+	if (transition_ptr_list[transition_index]->settingsNeedUpdate()) {
+		// a transition we've just started: show where it begins right away
+		sendCurTransitionSettings();
+	}
+
+	return 0;
+}
+VaRGBTimeValue Schedule::ticksUntilNextChange() {
+
+	if (transition_num < 1) {
+		return VaRGB_TIMEVALUE_MAX;
+	}
+
+	return transition_ptr_list[transition_index]->ticksUntilNextChange();
 }
+
 void Schedule::sendCurTransitionSettings() {
 
 	if (transition_num < 1) {
@@ -162,24 +307,39 @@ void Schedule::sendCurTransitionSettings() {
 	transition_ptr_list[transition_index]->settingsUpdated();
 }
 
-bool Schedule::expandTransitionList(uint8_t by_amount) {
+bool Schedule::expandTransitionList(uint16_t by_amount) {
+
+	if (fixed_list) {
+		// as big as it gets
+		return false;
+	}
 
 	int curveitm_ptr_size = sizeof(vargb::Curve::Curve *);
 	vargb::Curve::Curve ** new_list = NULL;
+	VaRGBTimeValue * new_starts = NULL;
 
 	if (!by_amount) {
 		// set optional param to default value
 		by_amount = VaRGB_SCHEDULE_CURVELIST_EXPAND_BYAMOUNT;
 	}
 
+	// the start tick table follows the curve list, entry for entry.
+	new_starts = (VaRGBTimeValue*) VaRGB_REALLOC(transition_start_ticks,
+			sizeof(VaRGBTimeValue) * (transition_max + by_amount));
+	if (new_starts == NULL) {
+		// abject failure...
+		return false;
+	}
+	transition_start_ticks = new_starts;
+
 	if (transition_ptr_list) {
 		// we've already got a list in hand... we want to expand it a bit
-		new_list = (vargb::Curve::Curve**) realloc(transition_ptr_list,
-				curveitm_ptr_size * (transition_num + by_amount));
+		new_list = (vargb::Curve::Curve**) VaRGB_REALLOC(transition_ptr_list,
+				curveitm_ptr_size * (transition_max + by_amount));
 
 	} else {
 		// no list yet, malloc one please:
-		new_list = (vargb::Curve::Curve**) malloc(
+		new_list = (vargb::Curve::Curve**) VaRGB_MALLOC(
 				curveitm_ptr_size * by_amount);
 
 	}
@@ -187,12 +347,12 @@ bool Schedule::expandTransitionList(uint8_t by_amount) {
 	if (new_list != NULL) {
 		// we gots a new list, huzzah.
 
+		// zero the newly allocated memory
+		memset(&(new_list[transition_max]), 0, curveitm_ptr_size * by_amount);
+
 		// make note of our new space...
 		transition_max += by_amount;
 
-		// zero the newly allocated memory
-		memset(&(new_list[transition_num]), 0, curveitm_ptr_size * by_amount);
-
 		// keep that pointer
 		transition_ptr_list = new_list;
 
@@ -0,0 +1,94 @@
+/*
+
+ ScheduleCursor.cpp -- per-fixture playback of shared schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/ScheduleCursor.h"
+
+namespace vargb {
+
+ScheduleCursor::ScheduleCursor(const Schedule * sched, VaRGBTimeValue start_tick) :
+		cur_schedule(NULL),
+		tick_position(0),
+		run_completed(false)
+{
+	current_settings.red = 0;
+	current_settings.green = 0;
+	current_settings.blue = 0;
+
+	if (sched)
+	{
+		setSchedule(sched, start_tick);
+	}
+}
+
+void ScheduleCursor::setSchedule(const Schedule * sched, VaRGBTimeValue start_tick)
+{
+	cur_schedule = sched;
+	tick_position = 0;
+	run_completed = false;
+	if (sched && sched->totalTicks())
+	{
+		tick_position = start_tick % sched->totalTicks();
+	}
+
+	update();
+}
+
+bool ScheduleCursor::tick(VaRGBTimeValue num)
+{
+	run_completed = false;
+	if (! (cur_schedule && cur_schedule->totalTicks()))
+	{
+		return false;
+	}
+
+	VaRGBTimeProduct new_position = (VaRGBTimeProduct)tick_position + num;
+	if (new_position >= cur_schedule->totalTicks())
+	{
+		run_completed = true;
+		new_position %= cur_schedule->totalTicks();
+	}
+	tick_position = new_position;
+
+	return update();
+}
+
+bool ScheduleCursor::update()
+{
+	if (! cur_schedule)
+	{
+		return false;
+	}
+
+	IlluminationSettings illum = cur_schedule->valueAt(tick_position);
+	if (illum.values[vargb_red_idx] == current_settings.red
+			&& illum.values[vargb_green_idx] == current_settings.green
+			&& illum.values[vargb_blue_idx] == current_settings.blue)
+	{
+		return false;
+	}
+
+	current_settings.red = illum.values[vargb_red_idx];
+	current_settings.green = illum.values[vargb_green_idx];
+	current_settings.blue = illum.values[vargb_blue_idx];
+	return true;
+}
+
+} /* namespace vargb */
@@ -0,0 +1,234 @@
+/*
+
+ SharedFrame.cpp -- frame publication through shared memory, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "includes/SharedFrame.h"
+
+namespace vargb {
+
+static size_t sharedFrameRegionLen(uint32_t num_fixtures)
+{
+	return sizeof(SharedFrameHeader) + (sizeof(ColorSettings) * num_fixtures);
+}
+
+
+SharedFrameWriter::SharedFrameWriter(const char * name, VaRGBFixtureIndex num_fixtures) :
+		header(NULL),
+		colors(NULL),
+		region_len(sharedFrameRegionLen(num_fixtures))
+{
+	int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+	if (fd < 0)
+	{
+		return;
+	}
+
+	void * region = MAP_FAILED;
+	if (ftruncate(fd, region_len) == 0)
+	{
+		region = mmap(NULL, region_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+
+	if (region == MAP_FAILED)
+	{
+		return;
+	}
+
+	header = (SharedFrameHeader*) region;
+	colors = (ColorSettings*) ((uint8_t*) region + sizeof(SharedFrameHeader));
+
+	// odd sequence while we set up, so readers of a re-used region back off
+	__atomic_store_n(&(header->sequence), 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	header->version = VaRGB_SHAREDFRAME_VERSION;
+	header->header_size = sizeof(SharedFrameHeader);
+	header->num_fixtures = num_fixtures;
+	header->frame_number = 0;
+	memset(colors, 0, sizeof(ColorSettings) * num_fixtures);
+	memcpy(header->magic, VaRGB_SHAREDFRAME_MAGIC, sizeof(header->magic));
+
+	__atomic_store_n(&(header->sequence), 2, __ATOMIC_RELEASE);
+}
+
+SharedFrameWriter::~SharedFrameWriter()
+{
+	close();
+}
+
+void SharedFrameWriter::close()
+{
+	if (header)
+	{
+		munmap(header, region_len);
+		header = NULL;
+		colors = NULL;
+	}
+}
+
+bool SharedFrameWriter::remove(const char * name)
+{
+	return shm_unlink(name) == 0;
+}
+
+void SharedFrameWriter::publish(const ColorSettings * frame, const uint8_t * dirty_bits)
+{
+	if (! header)
+	{
+		return;
+	}
+
+	uint32_t seq = header->sequence;
+	__atomic_store_n(&(header->sequence), seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	if (dirty_bits)
+	{
+		for (uint32_t i = 0; i < header->num_fixtures; i++)
+		{
+			if (dirty_bits[i / 8] & (1 << (i % 8)))
+			{
+				colors[i] = frame[i];
+			}
+		}
+	} else {
+		memcpy(colors, frame, sizeof(ColorSettings) * header->num_fixtures);
+	}
+	header->frame_number++;
+
+	__atomic_store_n(&(header->sequence), seq + 2, __ATOMIC_RELEASE);
+}
+
+
+SharedFrameReader::SharedFrameReader() :
+		header(NULL),
+		colors(NULL),
+		region_len(0)
+{
+
+}
+
+SharedFrameReader::~SharedFrameReader()
+{
+	close();
+}
+
+bool SharedFrameReader::open(const char * name)
+{
+	close();
+
+	int fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	void * region = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(SharedFrameHeader))
+	{
+		region_len = st.st_size;
+		region = mmap(NULL, region_len, PROT_READ, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+
+	if (region == MAP_FAILED)
+	{
+		return false;
+	}
+
+	const SharedFrameHeader * hdr = (const SharedFrameHeader*) region;
+	if (memcmp(hdr->magic, VaRGB_SHAREDFRAME_MAGIC, sizeof(hdr->magic)) != 0
+			|| hdr->version != VaRGB_SHAREDFRAME_VERSION
+			|| region_len < sharedFrameRegionLen(hdr->num_fixtures))
+	{
+		munmap(region, region_len);
+		return false;
+	}
+
+	header = hdr;
+	colors = (const volatile ColorSettings*) ((const uint8_t*) region + hdr->header_size);
+	return true;
+}
+
+void SharedFrameReader::close()
+{
+	if (header)
+	{
+		munmap((void*) header, region_len);
+		header = NULL;
+		colors = NULL;
+	}
+}
+
+uint32_t SharedFrameReader::beginRead()
+{
+	uint32_t seq;
+	while ((seq = __atomic_load_n(&(header->sequence), __ATOMIC_ACQUIRE)) & 1)
+	{
+		// writer's in the middle of a frame
+		sched_yield();
+	}
+	return seq;
+}
+
+bool SharedFrameReader::endRead(uint32_t token)
+{
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return __atomic_load_n(&(header->sequence), __ATOMIC_RELAXED) == token;
+}
+
+uint32_t SharedFrameReader::snapshot(ColorSettings * into)
+{
+	uint32_t token;
+	uint32_t frame_num;
+	do {
+		token = beginRead();
+		for (uint32_t i = 0; i < header->num_fixtures; i++)
+		{
+			into[i].red = colors[i].red;
+			into[i].green = colors[i].green;
+			into[i].blue = colors[i].blue;
+		}
+		frame_num = header->frame_number;
+	} while (! endRead(token));
+
+	return frame_num;
+}
+
+uint32_t SharedFrameReader::frameNumber()
+{
+	return __atomic_load_n(&(header->frame_number), __ATOMIC_RELAXED);
+}
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
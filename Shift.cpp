@@ -41,7 +41,8 @@ Shift::Shift(vargb::Curve::Curve * curve, uint8_t bits, ShiftDir direction)
 
 }
 
-void Shift::childUpdated()
+void Shift::combine(const IlluminationSettings * child_settings[],
+		IlluminationSettings * into) const
 {
 
 	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
@@ -49,14 +50,21 @@ void Shift::childUpdated()
 		if (shift_dir == ShiftLeft)
 		{
 			// need to apply the shift left
-			current_settings.values[i] = curves[0]->currentSettings()->values[i] << shift_bits;
+			into->values[i] = child_settings[0]->values[i] << shift_bits;
 		} else {
-			current_settings.values[i] = curves[0]->currentSettings()->values[i] >> shift_bits;
+			into->values[i] = child_settings[0]->values[i] >> shift_bits;
 		}
 	}
 
 
 }
+
+void Shift::describe(LogicInstruction * into) const
+{
+	into->opcode = (shift_dir == ShiftLeft) ? LogicOpShiftLeft : LogicOpShiftRight;
+	into->value = shift_bits;
+}
+
 } /* namespace Curve */
 } /* namespace vargb */
 
@@ -32,6 +32,52 @@
 #define TWO_PI 6.283185307179586476925286766559
 #endif
 
+#ifdef VaRGB_SINE_LUT
+/*
+ * Quarter-wave sine table: sin(i * (PI/2) / 256) * 32768, for i in 0..256
+ * (the 257th entry, at 90 degrees, lets us mirror the table exactly).  The
+ * other three quarters of the wave are derived by symmetry.
+ */
+#define sine_lut_quarter_bits		8
+#define sine_lut_quarter_size		(1 << sine_lut_quarter_bits)
+
+static const uint16_t sine_quarter_wave[sine_lut_quarter_size + 1] VaRGB_PROGMEM = {
+	    0,   201,   402,   603,   804,  1005,  1206,  1407,
+	 1608,  1809,  2009,  2210,  2411,  2611,  2811,  3012,
+	 3212,  3412,  3612,  3812,  4011,  4211,  4410,  4609,
+	 4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+	 6393,  6590,  6787,  6983,  7180,  7376,  7571,  7767,
+	 7962,  8157,  8351,  8546,  8740,  8933,  9127,  9319,
+	 9512,  9704,  9896, 10088, 10279, 10469, 10660, 10850,
+	11039, 11228, 11417, 11605, 11793, 11980, 12167, 12354,
+	12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+	14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269,
+	15447, 15624, 15800, 15976, 16151, 16326, 16500, 16673,
+	16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+	18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358,
+	19520, 19681, 19841, 20001, 20160, 20318, 20475, 20632,
+	20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+	22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028,
+	23170, 23312, 23453, 23593, 23732, 23870, 24008, 24144,
+	24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+	25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199,
+	26320, 26439, 26557, 26674, 26791, 26906, 27020, 27133,
+	27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+	28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803,
+	28899, 28993, 29086, 29178, 29269, 29359, 29448, 29535,
+	29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+	30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784,
+	30853, 30920, 30986, 31050, 31114, 31177, 31238, 31298,
+	31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+	31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099,
+	32138, 32177, 32214, 32251, 32286, 32319, 32352, 32383,
+	32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+	32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718,
+	32729, 32738, 32746, 32753, 32758, 32762, 32766, 32767,
+	32768
+};
+#endif
+
 
 namespace vargb {
 namespace Curve {
@@ -43,19 +89,16 @@ Sine::Sine(VaRGBColorValue target_red, VaRGBColorValue target_green,
 		VaRGBColorValue target_blue, VaRGBTimeValue time_seconds,
 		uint8_t secs_per_cycle, uint16_t phase_degrees) :
 		Curve(target_red, target_green, target_blue, time_seconds),
-		ticks_per_cycle(VaRGB_SECONDS_TO_UNITTIME(secs_per_cycle)),
-		radians_current(0)
+		ticks_per_cycle(VaRGB_SECONDS_TO_UNITTIME(secs_per_cycle))
 {
-	increment_per_tick = TWO_PI / ticks_per_cycle;
-	if (phase_degrees < 1)
+	if (ticks_per_cycle < 1)
 	{
-		phase_adjustment = 0;
-
-	} else {
-
-		phase_adjustment = (TWO_PI * phase_degrees) / 360.00f;
+		ticks_per_cycle = 1;
 	}
 
+	increment_per_tick = phaseStepFor(ticks_per_cycle);
+	phase_adjustment = phaseFor(phase_degrees);
+
 }
 
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
@@ -65,64 +108,119 @@ Sine::~Sine() {
 #endif
 
 
-void Sine::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
+#ifdef VaRGB_SINE_LUT
+
+SinePhaseStep Sine::phaseStepFor(VaRGBTimeValue ticks_per_cycle)
 {
+	// (tick % ticks_per_cycle) * step stays below 2^32
+	return 0xFFFFFFFFUL / ticks_per_cycle;
+}
 
-	resetCurrentSettings(initial_settings);
+SinePhase Sine::phaseFor(uint16_t phase_degrees)
+{
+	return ((uint32_t)(phase_degrees % 360) << 16) / 360;
+}
+
+SineFactor Sine::sinFactorAt(VaRGBTimeValue tick_count, VaRGBTimeValue ticks_per_cycle,
+		SinePhaseStep increment_per_tick, SinePhase phase_adjustment)
+{
+	SinePhase phase = (SinePhase)(((uint32_t)(tick_count % ticks_per_cycle) * increment_per_tick) >> 16)
+			+ phase_adjustment;
 
-	if (setTo < 2)
+	// top two bits give the quarter of the wave, the next few our spot within it
+	uint8_t quarter = phase >> 14;
+	uint16_t idx = (phase >> (14 - sine_lut_quarter_bits)) & (sine_lut_quarter_size - 1);
+	if (quarter & 0x01)
 	{
-		radians_current = 0;
+		// falling quarters mirror the rising ones
+		idx = sine_lut_quarter_size - idx;
+	}
 
-	} else {
+	uint16_t sin_value = VaRGB_READ_TABLE_WORD(&(sine_quarter_wave[idx]));
 
-		VaRGBTimeValue remainderTicks = (setTo - 1) % ticks_per_cycle;
+	// between -1 and 1 so we shift up and div by two
+	return (quarter & 0x02) ? 32768 - sin_value : 32768 + sin_value;
+}
 
-		radians_current = increment_per_tick * remainderTicks;
+#else
 
-		// small error here, whatev's
+SinePhaseStep Sine::phaseStepFor(VaRGBTimeValue ticks_per_cycle)
+{
+	return TWO_PI / ticks_per_cycle;
+}
 
+SinePhase Sine::phaseFor(uint16_t phase_degrees)
+{
+	if (phase_degrees < 1)
+	{
+		return 0;
 	}
 
+	return (TWO_PI * phase_degrees) / 360.00f;
+}
+
+SineFactor Sine::sinFactorAt(VaRGBTimeValue tick_count, VaRGBTimeValue ticks_per_cycle,
+		SinePhaseStep increment_per_tick, SinePhase phase_adjustment)
+{
+	float radians = increment_per_tick * (tick_count % ticks_per_cycle);
+
+	return (sin(radians + phase_adjustment) + 1.0)/2.0; // between -1 and 1 so we shift up and div by two
+}
+
+// VaRGB_SINE_LUT
+#endif
+
+void Sine::setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings)
+{
+
+	resetCurrentSettings(initial_settings);
+
 	tick_count = setTo;
 
-	tick();
+	updateValues();
 
 
 }
 
-void Sine::tick(uint8_t num)
+void Sine::tick(VaRGBTimeValue num)
 {
-	double sinFactor;
-	VaRGBTimeValue remainderTicks;
+	tick_count += num;
 
-	for (uint8_t i=0; i<num; i++)
+	if (tick_count >= curve_target.transition_ticks)
 	{
-		tick_count++;
+		curve_completed = true;
+	}
 
-		if (tick_count >= curve_target.transition_ticks)
-		{
-			curve_completed = true;
-		}
-		remainderTicks = tick_count % ticks_per_cycle;
-		if (remainderTicks == 0)
-		{
-			radians_current = 0;
-		} else {
-			radians_current += increment_per_tick;
-		}
+	updateValues();
 
-		sinFactor = (sin(radians_current + phase_adjustment) + 1.0)/2.0; // between -1 and 1 so we shift up and div by two
+}
 
+void Sine::updateValues()
+{
+	// values always lead the tick count by one step
+	SineFactor sinFactor = sinFactorAt(tick_count + 1, ticks_per_cycle, increment_per_tick, phase_adjustment);
 
-		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
-		{
-			current_settings.values[c] = curve_target.values[c] * sinFactor;
-		}
-		settings_req_update = true;
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		current_settings.values[c] = scaleBy(curve_target.values[c], sinFactor);
+	}
+	settings_req_update = true;
+}
+
+IlluminationSettings Sine::valueAt(VaRGBTimeValue tick,
+		const IlluminationSettings* start_settings) const
+{
+	IlluminationSettings value;
 
+	// values lead the tick count by one step (see updateValues())
+	SineFactor sinFactor = sinFactorAt(tick + 1, ticks_per_cycle, increment_per_tick, phase_adjustment);
+
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		value.values[c] = scaleBy(curve_target.values[c], sinFactor);
 	}
 
+	return value;
 }
 
 
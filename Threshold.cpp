@@ -41,7 +41,8 @@ Threshold::Threshold(vargb::Curve::Curve * curve, VaRGBColorValue value, Thresho
 
 }
 
-void Threshold::childUpdated()
+void Threshold::combine(const IlluminationSettings * child_settings[],
+		IlluminationSettings * into) const
 {
 
 	for (uint8_t i=0; i<VaRGB_NUM_COLORS; i++)
@@ -49,18 +50,26 @@ void Threshold::childUpdated()
 		if (threshold_dir == ThresholdAbove)
 		{
 			// only counts if ABOVE
-			current_settings.values[i] = curves[0]->currentSettings()->values[i] > threshold  ?
-					curves[0]->currentSettings()->values[i] :
+			into->values[i] = child_settings[0]->values[i] > threshold  ?
+					child_settings[0]->values[i] :
 					default_value;
 		} else {
-			current_settings.values[i] = curves[0]->currentSettings()->values[i] < threshold  ?
-								curves[0]->currentSettings()->values[i] :
+			into->values[i] = child_settings[0]->values[i] < threshold  ?
+								child_settings[0]->values[i] :
 								default_value;
 		}
 	}
 
 
 }
+
+void Threshold::describe(LogicInstruction * into) const
+{
+	into->opcode = (threshold_dir == ThresholdAbove) ? LogicOpThresholdAbove : LogicOpThresholdBelow;
+	into->value = threshold;
+	into->alt_value = default_value;
+}
+
 } /* namespace Curve */
 } /* namespace vargb */
 
@@ -0,0 +1,105 @@
+/*
+
+ TickClock.cpp -- monotonic tick clock, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include "includes/VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <errno.h>
+#include "includes/TickClock.h"
+
+#define tickclock_ns_per_sec	1000000000ULL
+
+namespace vargb {
+
+TickClock::TickClock(uint32_t ms_per_tick) :
+		ns_per_tick((uint64_t)ms_per_tick * 1000000ULL),
+		start_ns(0),
+		ticks_delivered(0)
+{
+	if (ns_per_tick < 1)
+	{
+		ns_per_tick = 1;
+	}
+	reset();
+}
+
+uint64_t TickClock::nowNs()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * tickclock_ns_per_sec) + now.tv_nsec;
+}
+
+void TickClock::reset()
+{
+	start_ns = nowNs();
+	ticks_delivered = 0;
+}
+
+uint64_t TickClock::ticksSinceStart()
+{
+	return (nowNs() - start_ns) / ns_per_tick;
+}
+
+VaRGBTickCount TickClock::elapsedTicks()
+{
+	uint64_t elapsed = ticksSinceStart() - ticks_delivered;
+	ticks_delivered += elapsed;
+	return (VaRGBTickCount)elapsed;
+}
+
+VaRGBTickCount TickClock::waitForTicks(VaRGBTickCount min_ticks)
+{
+	uint64_t elapsed = ticksSinceStart() - ticks_delivered;
+
+	if (min_ticks < 1)
+	{
+		min_ticks = 1;
+	}
+
+	if (elapsed < min_ticks)
+	{
+		// sleep until the tick we want is due.  Deadlines are absolute, so
+		// however late we wake up this time, the next one isn't pushed back.
+		uint64_t deadline = start_ns + ((ticks_delivered + min_ticks) * ns_per_tick);
+		struct timespec wake_at;
+		wake_at.tv_sec = deadline / tickclock_ns_per_sec;
+		wake_at.tv_nsec = deadline % tickclock_ns_per_sec;
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_at, NULL) == EINTR)
+		{
+		}
+
+		elapsed = ticksSinceStart() - ticks_delivered;
+		if (elapsed < min_ticks)
+		{
+			elapsed = min_ticks;
+		}
+	}
+
+	ticks_delivered += elapsed;
+	return (VaRGBTickCount)elapsed;
+}
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
@@ -33,7 +33,10 @@ VaRGB::VaRGB(VaRGB_SetColor_Callback set_color_with_cb, VaRGB_Schedule_Completed
 		set_color_forsched_cb(NULL),
 		sched_completed_cb(sched_comp_cb),
 		current_schedule(NULL),
-		tick_count(0)
+		tick_count(0),
+		frame_slot(NULL),
+		frame_dirty_bits(NULL),
+		frame_fixture(0)
 {
 
 }
@@ -43,7 +46,10 @@ VaRGB::VaRGB(VaRGB_SetColorForSchedule_Callback set_color_for_sched_with_cb, VaR
 		set_color_forsched_cb(set_color_for_sched_with_cb),
 		sched_completed_cb(sched_comp_cb),
 		current_schedule(NULL),
-		tick_count(0)
+		tick_count(0),
+		frame_slot(NULL),
+		frame_dirty_bits(NULL),
+		frame_fixture(0)
 {
 
 }
@@ -72,6 +78,11 @@ void VaRGB::scheduleComplete(Schedule* sched)
 	if (sched_completed_cb)
 	{
 		sched_completed_cb(sched);
+		if (current_schedule == sched && sched->runCompleted())
+		{
+			// kept as is, without a setSchedule(): on to the next run
+			sched->setTick(0);
+		}
 	} else {
 		// no schedule-completed callback... will be keeping this
 		// sched, I guess, so we auto-reset
@@ -81,9 +92,28 @@ void VaRGB::scheduleComplete(Schedule* sched)
 	}
 }
 
+void VaRGB::setFrameOutput(ColorSettings * slot, uint8_t * dirty_bits, VaRGBFixtureIndex fixture)
+{
+	frame_slot = slot;
+	frame_dirty_bits = dirty_bits;
+	frame_fixture = fixture;
+}
+
+void VaRGB::refreshColor()
+{
+	if (current_schedule)
+	{
+		current_schedule->sendCurTransitionSettings();
+	}
+}
+
 void VaRGB::setColor(Schedule* for_sched, ColorSettings * setTo)
 {
-	if (set_color_cb)
+	if (frame_slot)
+	{
+		*frame_slot = *setTo;
+		frame_dirty_bits[frame_fixture / 8] |= (1 << (frame_fixture % 8));
+	} else if (set_color_cb)
 	{
 		set_color_cb(setTo);
 	} else if (set_color_forsched_cb)
@@ -93,17 +123,89 @@ void VaRGB::setColor(Schedule* for_sched, ColorSettings * setTo)
 
 }
 
-void VaRGB::tick(uint8_t amount)
+void VaRGB::tick(VaRGBTimeValue amount)
 {
-	current_schedule->tick(amount);
-	tick_count += amount;
+	while (current_schedule && amount)
+	{
+		Schedule * sched = current_schedule;
+		VaRGBTimeValue leftover = sched->tick(amount);
+		tick_count += amount - leftover;
+
+		if (! sched->runCompleted())
+		{
+			return;
+		}
+
+		// schedule is done: the callback (or auto-reset) may hand us
+		// a new schedule, which gets whatever ticks remain.
+		scheduleComplete(sched);
+		amount = leftover;
+	}
 }
 
-void VaRGB::tickAndDelay(uint8_t num)
+void VaRGB::tickAndDelay(VaRGBTimeValue num)
 {
 	tick(num);
 	vargb::delayMs(num * tickDelayTimeMs());
 
 }
 
+VaRGBTimeValue VaRGB::ticksUntilNextChange()
+{
+	if (! current_schedule)
+	{
+		return VaRGB_TIMEVALUE_MAX;
+	}
+
+	return current_schedule->ticksUntilNextChange();
+}
+
+VaRGBTimeValue VaRGB::tickAtNextChange(VaRGBTimeValue max_ticks)
+{
+	VaRGBTimeValue num = ticksUntilNextChange();
+	if (num > max_ticks)
+	{
+		num = max_ticks;
+	}
+
+	vargb::delayMs((unsigned long)num * tickDelayTimeMs());
+	tick(num);
+
+	return num;
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+VaRGBTickCount VaRGB::tickAtNextChange(TickClock * clock, VaRGBTimeValue max_ticks)
+{
+	VaRGBTimeValue num = ticksUntilNextChange();
+	if (num > max_ticks)
+	{
+		num = max_ticks;
+	}
+
+	VaRGBTickCount elapsed = clock->waitForTicks(num);
+	VaRGBTickCount remaining = elapsed;
+	while (remaining > 0)
+	{
+		VaRGBTimeValue step = remaining > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : remaining;
+		tick(step);
+		remaining -= step;
+	}
+
+	return elapsed;
+}
+
+void VaRGB::tickAndWait(TickClock * clock)
+{
+	VaRGBTickCount elapsed = clock->waitForTicks();
+
+	while (elapsed > 0)
+	{
+		VaRGBTimeValue num = elapsed > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : elapsed;
+		tick(num);
+		elapsed -= num;
+	}
+}
+#endif
+
 } /* end namespace vargb */
@@ -85,6 +85,8 @@
 #include "includes/VaRGBConfig.h"
 #include "includes/VaRGBPlatform.h"
 #include "includes/Schedule.h"
+#include "includes/BakedSchedule.h"
+#include "includes/ScheduleCursor.h"
 
 namespace vargb {
 
@@ -178,15 +180,66 @@ public:
 	 * Inform the schedule and its currently running curve of the passage of time, by tick()ing the clock.
 	 *
 	 * Do this every VaRGB::tickDelayTimeMs() milliseconds, as described above and in the samples.
+	 * If you've fallen behind, tick(n) catches up n ticks in one go, moving through
+	 * as many transitions (and schedule completions) as required.
 	 */
-	void tick(uint8_t num=1);
+	void tick(VaRGBTimeValue num=1);
 
 	/*
 	 * tickAndDelay
 	 * If your code isn't spending much time doing anything other than driving the RGB LEDs, then you
 	 * can use this convenience function to tick() and delay tickDelayTimeMs() millis for you.
 	 */
-	void tickAndDelay(uint8_t num=1);
+	void tickAndDelay(VaRGBTimeValue num=1);
+
+	/*
+	 * ticksUntilNextChange
+	 * The number of ticks before the current schedule might next change the
+	 * colors (or complete).  Nothing happens during the ticks in between.
+	 */
+	VaRGBTimeValue ticksUntilNextChange();
+
+	/*
+	 * tickAtNextChange
+	 * Tickless alternative to tickAndDelay: rather than waking up every tick,
+	 * delays until the next change is due and tick()s all the way there in
+	 * one go.  Pass max_ticks to wake up at least that often, e.g. if you have
+	 * other work to do.  Returns the number of ticks that went by.
+	 */
+	VaRGBTimeValue tickAtNextChange(VaRGBTimeValue max_ticks=VaRGB_TIMEVALUE_MAX);
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	/*
+	 * tickAndWait
+	 * Host equivalent of tickAndDelay: sleeps until the clock says the next tick is
+	 * due, then tick()s by however many ticks have actually elapsed--so the lights
+	 * catch up, rather than drift, if the process was held up.
+	 */
+	void tickAndWait(TickClock * clock);
+
+	/*
+	 * tickAtNextChange
+	 * Host version of the tickless tickAtNextChange() above: sleeps on the clock
+	 * until the next change is due, then catches up on every tick elapsed.
+	 */
+	VaRGBTickCount tickAtNextChange(TickClock * clock, VaRGBTimeValue max_ticks=VaRGB_TIMEVALUE_MAX);
+#endif
+
+
+	/*
+	 * setFrameOutput
+	 * Batched output: rather than calling the set-color callback, the driver
+	 * writes its colors to frame_slot and sets bit 'fixture' of the dirty_bits
+	 * bitset whenever they change.  Pass NULLs to go back to using the callback.
+	 * Normally handled for you by a DriverGroup created with a frame callback.
+	 */
+	void setFrameOutput(ColorSettings * frame_slot, uint8_t * dirty_bits, VaRGBFixtureIndex fixture);
+
+	/*
+	 * refreshColor
+	 * Sends the current schedule's colors out again, whether or not they've changed.
+	 */
+	void refreshColor();
 
 
 	// used internally: setColor/scheduleComplete (called by Schedule on driver to notify callbacks)
@@ -202,6 +255,11 @@ private:
 	Schedule * current_schedule;
 	VaRGBTimeValue tick_count;
 
+	// batched output, when in use
+	ColorSettings * frame_slot;
+	uint8_t * frame_dirty_bits;
+	VaRGBFixtureIndex frame_fixture;
+
 
 
 };
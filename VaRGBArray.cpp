@@ -0,0 +1,733 @@
+/*
+
+ VaRGBArray.cpp -- multi-fixture VaRGB driver implementation, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "includes/VaRGBArray.h"
+#include "VaRGBCurves.h"
+
+
+// fixture_flags bits
+#define array_flag_dirty		0x01
+#define array_flag_completed	0x02
+
+// columns common to all pools
+#define array_col_fixture		0
+#define array_col_ticks			1
+#define array_col_transticks	2
+
+// Linear pool columns
+#define array_col_lin_increments	3
+#ifdef VaRGB_LINEAR_DDA
+#define array_col_lin_steps			(array_col_lin_increments + VaRGB_NUM_COLORS)
+#define array_col_lin_remainders	(array_col_lin_steps + VaRGB_NUM_COLORS)
+#define array_col_lin_errors		(array_col_lin_remainders + VaRGB_NUM_COLORS)
+#define array_num_cols_linear		(array_col_lin_errors + VaRGB_NUM_COLORS)
+#else
+#define array_col_lin_delays		(array_col_lin_increments + VaRGB_NUM_COLORS)
+#define array_num_cols_linear		(array_col_lin_delays + VaRGB_NUM_COLORS)
+#endif
+
+// Flasher pool columns
+#define array_col_fl_interval		3
+#define array_col_fl_on				4
+#define array_col_fl_targets		5
+#define array_col_fl_bases			(array_col_fl_targets + VaRGB_NUM_COLORS)
+#define array_num_cols_flasher		(array_col_fl_bases + VaRGB_NUM_COLORS)
+
+// Sine pool columns
+#define array_col_sin_cycleticks	3
+#define array_col_sin_increment		4
+#define array_col_sin_phase			5
+#define array_col_sin_targets		6
+#define array_num_cols_sine			(array_col_sin_targets + VaRGB_NUM_COLORS)
+
+#define array_num_cols_common		3
+
+#define array_column(pool, idx, type)	((type*)((pool).columns[idx]))
+
+// column arrays are each aligned to this many bytes within a pool's storage
+#define array_column_alignment		8
+
+
+namespace vargb {
+
+
+static void * allocateColumns(void ** columns, const uint8_t * sizes, uint8_t num_columns,
+		VaRGBFixtureIndex num_entries)
+{
+	size_t spans[VaRGB_ARRAY_MAX_POOL_COLUMNS];
+	size_t total = 0;
+
+	for (uint8_t i=0; i < num_columns; i++)
+	{
+		spans[i] = (((size_t)sizes[i] * num_entries) + (array_column_alignment - 1))
+				& ~((size_t)array_column_alignment - 1);
+		total += spans[i];
+	}
+
+	uint8_t * storage = (uint8_t*)VaRGB_MALLOC(total ? total : 1);
+	if (! storage)
+	{
+		return NULL;
+	}
+
+	memset(storage, 0, total);
+
+	uint8_t * pos = storage;
+	for (uint8_t i=0; i < num_columns; i++)
+	{
+		columns[i] = pos;
+		pos += spans[i];
+	}
+
+	return storage;
+}
+
+
+VaRGBArray::VaRGBArray(VaRGBFixtureIndex num, VaRGBArray_SetColor_Callback set_color_with_cb,
+		VaRGBArray_Curve_Completed curve_comp_cb) :
+		set_color_cb(set_color_with_cb),
+		curve_completed_cb(curve_comp_cb),
+		num_fixtures(num),
+		fixture_type(NULL),
+		fixture_flags(NULL),
+		fixture_slot(NULL),
+		dirty_list(NULL),
+		num_dirty(0),
+		completed_list(NULL),
+		num_completed(0)
+{
+	memset(pools, 0, sizeof(pools));
+
+	void * columns[5 + VaRGB_NUM_COLORS];
+	uint8_t sizes[5 + VaRGB_NUM_COLORS] = {
+			sizeof(uint8_t), sizeof(uint8_t), sizeof(VaRGBFixtureIndex),
+			sizeof(VaRGBFixtureIndex), sizeof(VaRGBFixtureIndex)
+	};
+
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		sizes[5 + c] = sizeof(VaRGBColorValue);
+	}
+
+	// we keep the fixture state block in pools[ArrayCurveNone], which never
+	// holds any curves.
+	pools[ArrayCurveNone].storage = allocateColumns(columns, sizes, 5 + VaRGB_NUM_COLORS, num_fixtures);
+	if (! pools[ArrayCurveNone].storage)
+	{
+		DEBUG_OUTLN("VaRGBArray: could not allocate fixtures");
+		return;
+	}
+
+	fixture_type = (uint8_t*)columns[0];
+	fixture_flags = (uint8_t*)columns[1];
+	fixture_slot = (VaRGBFixtureIndex*)columns[2];
+	dirty_list = (VaRGBFixtureIndex*)columns[3];
+	completed_list = (VaRGBFixtureIndex*)columns[4];
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		fixture_values[c] = (VaRGBColorValue*)columns[5 + c];
+	}
+
+}
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+VaRGBArray::~VaRGBArray()
+{
+	for (uint8_t t=0; t < ArrayCurveNumTypes; t++)
+	{
+		if (pools[t].storage)
+		{
+			VaRGB_FREE(pools[t].storage);
+		}
+	}
+}
+#endif
+
+bool VaRGBArray::allocatePool(ArrayCurveType type)
+{
+	ArrayPool * pool = &(pools[type]);
+	uint8_t sizes[VaRGB_ARRAY_MAX_POOL_COLUMNS];
+
+	if (pool->storage)
+	{
+		return true;
+	}
+
+	sizes[array_col_fixture] = sizeof(VaRGBFixtureIndex);
+	sizes[array_col_ticks] = sizeof(VaRGBTimeValue);
+	sizes[array_col_transticks] = sizeof(VaRGBTimeValue);
+	pool->num_columns = array_num_cols_common;
+
+	switch (type)
+	{
+	case ArrayCurveLinear:
+		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+		{
+			sizes[array_col_lin_increments + c] = sizeof(Curve::VaRGBColorDelta);
+#ifdef VaRGB_LINEAR_DDA
+			sizes[array_col_lin_steps + c] = sizeof(int8_t);
+			sizes[array_col_lin_remainders + c] = sizeof(VaRGBTimeValue);
+			sizes[array_col_lin_errors + c] = sizeof(VaRGBTimeValue);
+#else
+			sizes[array_col_lin_delays + c] = sizeof(VaRGBTimeValue);
+#endif
+		}
+		pool->num_columns = array_num_cols_linear;
+		break;
+
+	case ArrayCurveFlasher:
+		sizes[array_col_fl_interval] = sizeof(VaRGBTimeValue);
+		sizes[array_col_fl_on] = sizeof(uint8_t);
+		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+		{
+			sizes[array_col_fl_targets + c] = sizeof(VaRGBColorValue);
+			sizes[array_col_fl_bases + c] = sizeof(VaRGBColorValue);
+		}
+		pool->num_columns = array_num_cols_flasher;
+		break;
+
+	case ArrayCurveSine:
+		sizes[array_col_sin_cycleticks] = sizeof(VaRGBTimeValue);
+		sizes[array_col_sin_increment] = sizeof(Curve::SinePhaseStep);
+		sizes[array_col_sin_phase] = sizeof(Curve::SinePhase);
+		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+		{
+			sizes[array_col_sin_targets + c] = sizeof(VaRGBColorValue);
+		}
+		pool->num_columns = array_num_cols_sine;
+		break;
+
+	default:
+		break;
+	}
+
+	for (uint8_t i=0; i < pool->num_columns; i++)
+	{
+		pool->column_sizes[i] = sizes[i];
+	}
+
+	pool->storage = allocateColumns(pool->columns, sizes, pool->num_columns, num_fixtures);
+
+	return (pool->storage != NULL);
+}
+
+bool VaRGBArray::prepareSlot(VaRGBFixtureIndex fixture, ArrayCurveType type, VaRGBTimeValue trans_ticks)
+{
+	if (fixture >= num_fixtures || ! allocatePool(type))
+	{
+		return false;
+	}
+
+	if (fixture_type[fixture] != type)
+	{
+		releaseSlot(fixture);
+
+		ArrayPool * pool = &(pools[type]);
+		VaRGBFixtureIndex slot = pool->count++;
+
+		array_column(*pool, array_col_fixture, VaRGBFixtureIndex)[slot] = fixture;
+		fixture_type[fixture] = type;
+		fixture_slot[fixture] = slot;
+	}
+
+	ArrayPool * pool = &(pools[type]);
+	VaRGBFixtureIndex slot = fixture_slot[fixture];
+	array_column(*pool, array_col_ticks, VaRGBTimeValue)[slot] = 0;
+	array_column(*pool, array_col_transticks, VaRGBTimeValue)[slot] = trans_ticks;
+
+	fixture_flags[fixture] &= ~array_flag_completed;
+
+	return true;
+}
+
+void VaRGBArray::releaseSlot(VaRGBFixtureIndex fixture)
+{
+	if (fixture_type[fixture] == ArrayCurveNone)
+	{
+		return;
+	}
+
+	ArrayPool * pool = &(pools[fixture_type[fixture]]);
+	VaRGBFixtureIndex slot = fixture_slot[fixture];
+	VaRGBFixtureIndex last = --(pool->count);
+
+	if (slot != last)
+	{
+		// move the last entry into the freed slot, to keep the pool packed
+		for (uint8_t i=0; i < pool->num_columns; i++)
+		{
+			uint8_t * col = (uint8_t*)pool->columns[i];
+			memcpy(&(col[slot * pool->column_sizes[i]]), &(col[last * pool->column_sizes[i]]),
+					pool->column_sizes[i]);
+		}
+
+		VaRGBFixtureIndex moved = array_column(*pool, array_col_fixture, VaRGBFixtureIndex)[slot];
+		fixture_slot[moved] = slot;
+	}
+
+	fixture_type[fixture] = ArrayCurveNone;
+}
+
+void VaRGBArray::stop(VaRGBFixtureIndex fixture)
+{
+	if (fixture < num_fixtures)
+	{
+		releaseSlot(fixture);
+		fixture_flags[fixture] &= ~array_flag_completed;
+	}
+}
+
+void VaRGBArray::currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into)
+{
+	into->red = fixture_values[vargb_red_idx][fixture];
+	into->green = fixture_values[vargb_green_idx][fixture];
+	into->blue = fixture_values[vargb_blue_idx][fixture];
+}
+
+void VaRGBArray::markDirty(VaRGBFixtureIndex fixture)
+{
+	if (! (fixture_flags[fixture] & array_flag_dirty))
+	{
+		fixture_flags[fixture] |= array_flag_dirty;
+		dirty_list[num_dirty++] = fixture;
+	}
+}
+
+void VaRGBArray::markCompleted(VaRGBFixtureIndex fixture)
+{
+	if (! (fixture_flags[fixture] & array_flag_completed))
+	{
+		fixture_flags[fixture] |= array_flag_completed;
+		completed_list[num_completed++] = fixture;
+	}
+}
+
+bool VaRGBArray::setConstant(VaRGBFixtureIndex fixture, VaRGBColorValue target_red,
+		VaRGBColorValue target_green, VaRGBColorValue target_blue, VaRGBTimeValue trans_time_seconds)
+{
+	if (! prepareSlot(fixture, ArrayCurveConstant, VaRGB_SECONDS_TO_UNITTIME(trans_time_seconds)))
+	{
+		return false;
+	}
+
+	fixture_values[vargb_red_idx][fixture] = target_red;
+	fixture_values[vargb_green_idx][fixture] = target_green;
+	fixture_values[vargb_blue_idx][fixture] = target_blue;
+	markDirty(fixture);
+
+	return true;
+}
+
+#ifdef VaRGB_ENABLE_CURVE_LINEAR
+bool VaRGBArray::setLinear(VaRGBFixtureIndex fixture, VaRGBColorValue target_red,
+		VaRGBColorValue target_green, VaRGBColorValue target_blue, VaRGBTimeValue trans_time_seconds,
+		IlluminationSettings* initial_settings)
+{
+	IlluminationTarget end_target(target_red, target_green, target_blue, trans_time_seconds);
+	Curve::IlluminationDelta delta;
+
+	if (! prepareSlot(fixture, ArrayCurveLinear, end_target.transition_ticks))
+	{
+		return false;
+	}
+
+	if (initial_settings)
+	{
+		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+		{
+			if (fixture_values[c][fixture] != initial_settings->values[c])
+			{
+				fixture_values[c][fixture] = initial_settings->values[c];
+				markDirty(fixture);
+			}
+		}
+	}
+
+	IlluminationTarget start_target(fixture_values[vargb_red_idx][fixture],
+			fixture_values[vargb_green_idx][fixture],
+			fixture_values[vargb_blue_idx][fixture], 0);
+
+	Curve::Linear::calcDelta(&start_target, &end_target, &delta);
+
+	ArrayPool * pool = &(pools[ArrayCurveLinear]);
+	VaRGBFixtureIndex slot = fixture_slot[fixture];
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		array_column(*pool, array_col_lin_increments + c, Curve::VaRGBColorDelta)[slot] = delta.increments[c];
+#ifdef VaRGB_LINEAR_DDA
+		array_column(*pool, array_col_lin_steps + c, int8_t)[slot] = delta.steps[c];
+		array_column(*pool, array_col_lin_remainders + c, VaRGBTimeValue)[slot] = delta.remainders[c];
+		array_column(*pool, array_col_lin_errors + c, VaRGBTimeValue)[slot] = delta.errors[c];
+#else
+		array_column(*pool, array_col_lin_delays + c, VaRGBTimeValue)[slot] = delta.delays[c];
+#endif
+	}
+
+	return true;
+}
+#endif
+
+#ifdef VaRGB_ENABLE_CURVE_FLASHER
+bool VaRGBArray::setFlasher(VaRGBFixtureIndex fixture, VaRGBColorValue target_red,
+		VaRGBColorValue target_green, VaRGBColorValue target_blue, VaRGBTimeValue time_seconds,
+		uint8_t numFlashes, IlluminationSettings* base_settings)
+{
+	IlluminationTarget target(target_red, target_green, target_blue, time_seconds);
+
+	if (! prepareSlot(fixture, ArrayCurveFlasher, target.transition_ticks))
+	{
+		return false;
+	}
+
+	if (numFlashes < 1)
+	{
+		numFlashes = 1;
+	}
+
+	VaRGBTimeValue toggle_interval = target.transition_ticks / (2 * numFlashes);
+	if (toggle_interval < 1)
+	{
+		toggle_interval = 1;
+	}
+
+	ArrayPool * pool = &(pools[ArrayCurveFlasher]);
+	VaRGBFixtureIndex slot = fixture_slot[fixture];
+	array_column(*pool, array_col_fl_interval, VaRGBTimeValue)[slot] = toggle_interval;
+	array_column(*pool, array_col_fl_on, uint8_t)[slot] = 0;
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		VaRGBColorValue base = base_settings ? base_settings->values[c] : 0;
+		array_column(*pool, array_col_fl_targets + c, VaRGBColorValue)[slot] = target.values[c];
+		array_column(*pool, array_col_fl_bases + c, VaRGBColorValue)[slot] = base;
+
+		// flashers start "off"
+		fixture_values[c][fixture] = base;
+	}
+
+	markDirty(fixture);
+
+	return true;
+}
+#endif
+
+#ifdef VaRGB_ENABLE_CURVE_SINE
+bool VaRGBArray::setSine(VaRGBFixtureIndex fixture, VaRGBColorValue target_red,
+		VaRGBColorValue target_green, VaRGBColorValue target_blue, VaRGBTimeValue time_seconds,
+		uint8_t seconds_per_cycle, uint16_t phase_degrees)
+{
+	IlluminationTarget target(target_red, target_green, target_blue, time_seconds);
+
+	if (! prepareSlot(fixture, ArrayCurveSine, target.transition_ticks))
+	{
+		return false;
+	}
+
+	VaRGBTimeValue ticks_per_cycle = VaRGB_SECONDS_TO_UNITTIME(seconds_per_cycle);
+	if (ticks_per_cycle < 1)
+	{
+		ticks_per_cycle = 1;
+	}
+
+	ArrayPool * pool = &(pools[ArrayCurveSine]);
+	VaRGBFixtureIndex slot = fixture_slot[fixture];
+	Curve::SinePhaseStep increment = Curve::Sine::phaseStepFor(ticks_per_cycle);
+	Curve::SinePhase phase = Curve::Sine::phaseFor(phase_degrees);
+
+	// just like the Sine curve, values lead the tick count by one step
+	Curve::SineFactor sinFactor = Curve::Sine::sinFactorAt(1, ticks_per_cycle, increment, phase);
+
+	array_column(*pool, array_col_sin_cycleticks, VaRGBTimeValue)[slot] = ticks_per_cycle;
+	array_column(*pool, array_col_sin_increment, Curve::SinePhaseStep)[slot] = increment;
+	array_column(*pool, array_col_sin_phase, Curve::SinePhase)[slot] = phase;
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		array_column(*pool, array_col_sin_targets + c, VaRGBColorValue)[slot] = target.values[c];
+		fixture_values[c][fixture] = Curve::Sine::scaleBy(target.values[c], sinFactor);
+	}
+
+	markDirty(fixture);
+
+	return true;
+}
+#endif
+
+
+void VaRGBArray::tickConstants(VaRGBTimeValue num)
+{
+	ArrayPool * pool = &(pools[ArrayCurveConstant]);
+	VaRGBFixtureIndex * fixtures = array_column(*pool, array_col_fixture, VaRGBFixtureIndex);
+	VaRGBTimeValue * ticks = array_column(*pool, array_col_ticks, VaRGBTimeValue);
+	VaRGBTimeValue * trans_ticks = array_column(*pool, array_col_transticks, VaRGBTimeValue);
+	VaRGBFixtureIndex count = pool->count;
+
+	for (VaRGBFixtureIndex s=0; s < count; s++)
+	{
+		ticks[s] += num;
+		if (ticks[s] >= trans_ticks[s])
+		{
+			markCompleted(fixtures[s]);
+		}
+	}
+}
+
+void VaRGBArray::tickLinears(VaRGBTimeValue num)
+{
+#ifdef VaRGB_ENABLE_CURVE_LINEAR
+	ArrayPool * pool = &(pools[ArrayCurveLinear]);
+	VaRGBFixtureIndex * fixtures = array_column(*pool, array_col_fixture, VaRGBFixtureIndex);
+	VaRGBTimeValue * ticks = array_column(*pool, array_col_ticks, VaRGBTimeValue);
+	VaRGBTimeValue * trans_ticks = array_column(*pool, array_col_transticks, VaRGBTimeValue);
+	VaRGBFixtureIndex count = pool->count;
+
+#ifdef VaRGB_LINEAR_DDA
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		Curve::VaRGBColorDelta * increments = array_column(*pool, array_col_lin_increments + c, Curve::VaRGBColorDelta);
+		int8_t * steps = array_column(*pool, array_col_lin_steps + c, int8_t);
+		VaRGBTimeValue * remainders = array_column(*pool, array_col_lin_remainders + c, VaRGBTimeValue);
+		VaRGBTimeValue * errors = array_column(*pool, array_col_lin_errors + c, VaRGBTimeValue);
+		VaRGBColorValue * values = fixture_values[c];
+
+		for (VaRGBFixtureIndex s=0; s < count; s++)
+		{
+			// same stepping as Linear::advance()
+			VaRGBTimeValue period = trans_ticks[s] ? trans_ticks[s] : 1;
+			if (ticks[s] >= period)
+			{
+				continue;
+			}
+			VaRGBTimeValue step_ticks = (num > period - ticks[s]) ? period - ticks[s] : num;
+
+			VaRGBColorValue prev_value = values[fixtures[s]];
+			if (step_ticks == 1)
+			{
+				// as in Linear::advance(), without overflowing the error
+				values[fixtures[s]] += increments[s];
+				if (errors[s] >= period - remainders[s])
+				{
+					errors[s] -= period - remainders[s];
+					values[fixtures[s]] += steps[s];
+				} else {
+					errors[s] += remainders[s];
+				}
+			} else {
+				VaRGBTimeProduct error_total = ((VaRGBTimeProduct)remainders[s] * step_ticks) + errors[s];
+				values[fixtures[s]] += (increments[s] * step_ticks)
+						+ (steps[s] * (int)(error_total / period));
+				errors[s] = error_total % period;
+			}
+
+			if (values[fixtures[s]] != prev_value)
+			{
+				markDirty(fixtures[s]);
+			}
+		}
+	}
+#else
+	for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+	{
+		Curve::VaRGBColorDelta * increments = array_column(*pool, array_col_lin_increments + c, Curve::VaRGBColorDelta);
+		VaRGBTimeValue * delays = array_column(*pool, array_col_lin_delays + c, VaRGBTimeValue);
+		VaRGBColorValue * values = fixture_values[c];
+
+		for (VaRGBFixtureIndex s=0; s < count; s++)
+		{
+			if (increments[s] == 0)
+			{
+				continue;
+			}
+
+			// update points crossed by moving num ticks ahead
+			VaRGBTimeValue num_updates = ((VaRGBTimeValue)(ticks[s] + num) / delays[s]) - (ticks[s] / delays[s]);
+			if (num_updates)
+			{
+				values[fixtures[s]] += num_updates * increments[s];
+				markDirty(fixtures[s]);
+			}
+		}
+	}
+#endif
+
+	for (VaRGBFixtureIndex s=0; s < count; s++)
+	{
+		ticks[s] += num;
+		if (ticks[s] >= trans_ticks[s])
+		{
+			markCompleted(fixtures[s]);
+		}
+	}
+#endif
+}
+
+void VaRGBArray::tickFlashers(VaRGBTimeValue num)
+{
+#ifdef VaRGB_ENABLE_CURVE_FLASHER
+	ArrayPool * pool = &(pools[ArrayCurveFlasher]);
+	VaRGBFixtureIndex * fixtures = array_column(*pool, array_col_fixture, VaRGBFixtureIndex);
+	VaRGBTimeValue * ticks = array_column(*pool, array_col_ticks, VaRGBTimeValue);
+	VaRGBTimeValue * trans_ticks = array_column(*pool, array_col_transticks, VaRGBTimeValue);
+	VaRGBTimeValue * intervals = array_column(*pool, array_col_fl_interval, VaRGBTimeValue);
+	uint8_t * is_on = array_column(*pool, array_col_fl_on, uint8_t);
+	VaRGBFixtureIndex count = pool->count;
+
+	for (VaRGBFixtureIndex s=0; s < count; s++)
+	{
+		VaRGBTimeValue new_count = ticks[s] + num;
+		bool toggled = (new_count / intervals[s]) != (ticks[s] / intervals[s]);
+		ticks[s] = new_count;
+
+		if (toggled)
+		{
+			is_on[s] = ((new_count / intervals[s]) % 2 != 0);
+			uint8_t src_col = is_on[s] ? array_col_fl_targets : array_col_fl_bases;
+			for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+			{
+				fixture_values[c][fixtures[s]] = array_column(*pool, src_col + c, VaRGBColorValue)[s];
+			}
+			markDirty(fixtures[s]);
+		}
+
+		if (ticks[s] >= trans_ticks[s])
+		{
+			markCompleted(fixtures[s]);
+		}
+	}
+#endif
+}
+
+void VaRGBArray::tickSines(VaRGBTimeValue num)
+{
+#ifdef VaRGB_ENABLE_CURVE_SINE
+	ArrayPool * pool = &(pools[ArrayCurveSine]);
+	VaRGBFixtureIndex * fixtures = array_column(*pool, array_col_fixture, VaRGBFixtureIndex);
+	VaRGBTimeValue * ticks = array_column(*pool, array_col_ticks, VaRGBTimeValue);
+	VaRGBTimeValue * trans_ticks = array_column(*pool, array_col_transticks, VaRGBTimeValue);
+	VaRGBTimeValue * cycle_ticks = array_column(*pool, array_col_sin_cycleticks, VaRGBTimeValue);
+	Curve::SinePhaseStep * increments = array_column(*pool, array_col_sin_increment, Curve::SinePhaseStep);
+	Curve::SinePhase * phases = array_column(*pool, array_col_sin_phase, Curve::SinePhase);
+	VaRGBFixtureIndex count = pool->count;
+
+	for (VaRGBFixtureIndex s=0; s < count; s++)
+	{
+		ticks[s] += num;
+
+		Curve::SineFactor sinFactor = Curve::Sine::sinFactorAt(ticks[s] + 1, cycle_ticks[s], increments[s], phases[s]);
+		bool changed = false;
+		for (uint8_t c=0; c < VaRGB_NUM_COLORS; c++)
+		{
+			VaRGBColorValue new_value = Curve::Sine::scaleBy(
+					array_column(*pool, array_col_sin_targets + c, VaRGBColorValue)[s], sinFactor);
+			if (fixture_values[c][fixtures[s]] != new_value)
+			{
+				fixture_values[c][fixtures[s]] = new_value;
+				changed = true;
+			}
+		}
+
+		// slow sines (and the flat bits at their peaks) often stay put
+		// for a few ticks: only send out actual changes
+		if (changed)
+		{
+			markDirty(fixtures[s]);
+		}
+
+		if (ticks[s] >= trans_ticks[s])
+		{
+			markCompleted(fixtures[s]);
+		}
+	}
+#endif
+}
+
+void VaRGBArray::tick(VaRGBTimeValue num)
+{
+	if (! valid())
+	{
+		return;
+	}
+
+	tickConstants(num);
+	tickLinears(num);
+	tickFlashers(num);
+	tickSines(num);
+
+	// send out the updates
+	ColorSettings cur_settings;
+	for (VaRGBFixtureIndex i=0; i < num_dirty; i++)
+	{
+		VaRGBFixtureIndex fixture = dirty_list[i];
+		fixture_flags[fixture] &= ~array_flag_dirty;
+		if (set_color_cb)
+		{
+			currentSettings(fixture, &cur_settings);
+			set_color_cb(fixture, &cur_settings);
+		}
+	}
+	num_dirty = 0;
+
+	// and let the world know about completed curves.  Completed fixtures
+	// which aren't given something new to do are stopped.
+	for (VaRGBFixtureIndex i=0; i < num_completed; i++)
+	{
+		VaRGBFixtureIndex fixture = completed_list[i];
+		if (! (fixture_flags[fixture] & array_flag_completed))
+		{
+			// already restarted by an earlier callback
+			continue;
+		}
+
+		if (curve_completed_cb)
+		{
+			curve_completed_cb(fixture);
+		}
+
+		if (fixture_flags[fixture] & array_flag_completed)
+		{
+			stop(fixture);
+		}
+	}
+	num_completed = 0;
+
+}
+
+void VaRGBArray::tickAndDelay(VaRGBTimeValue num)
+{
+	tick(num);
+	vargb::delayMs(num * tickDelayTimeMs());
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+void VaRGBArray::tickAndWait(TickClock * clock)
+{
+	VaRGBTickCount elapsed = clock->waitForTicks();
+
+	while (elapsed > 0)
+	{
+		VaRGBTimeValue num = elapsed > VaRGB_TIMEVALUE_MAX ? VaRGB_TIMEVALUE_MAX : elapsed;
+		tick(num);
+		elapsed -= num;
+	}
+}
+#endif
+
+} /* end namespace vargb */
@@ -79,7 +79,14 @@
 	#include "includes/Curves/Threshold.h"
 	#endif
 
+	#ifdef VaRGB_ENABLE_CURVE_COMPILEDLOGIC
+	#include "includes/Curves/Compiled.h"
+	#endif
+
 #endif
 
+// compile-time combinations
+#include "includes/Curves/Compose.h"
+
 
 #endif /* VARGBCURVES_H_ */
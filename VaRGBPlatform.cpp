@@ -22,6 +22,10 @@
 #include "includes/VaRGBConfig.h"
 #include "includes/VaRGBPlatform.h"
 
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+#include <errno.h>
+#endif
+
 namespace vargb {
 
 #ifdef VaRGB_TARGET_PLATFORM_ARDUINO
@@ -31,5 +35,75 @@ void delayMs(unsigned long ms) {
 }
 #endif
 
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+void delayMs(unsigned long ms) {
+
+	struct timespec wait_for;
+	wait_for.tv_sec = ms / 1000;
+	wait_for.tv_nsec = (ms % 1000) * 1000000L;
+
+	// restart with whatever remains, if a signal interrupts the sleep
+	while (clock_nanosleep(CLOCK_MONOTONIC, 0, &wait_for, &wait_for) == EINTR)
+	{
+	}
+}
+#endif
+
+
+#ifdef VaRGB_ALLOCATION_AUDIT
+
+static uint32_t allocations_made = 0;
+static uint32_t allocations_at_mark = 0;
+
+static void countAllocation()
+{
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	// allocations may happen on any thread
+	__atomic_fetch_add(&allocations_made, 1, __ATOMIC_RELAXED);
+#else
+	allocations_made++;
+#endif
+}
+
+void * auditedMalloc(size_t size) {
+	countAllocation();
+	return malloc(size);
+}
+
+void * auditedCalloc(size_t num, size_t size) {
+	countAllocation();
+	return calloc(num, size);
+}
+
+void * auditedRealloc(void * ptr, size_t size) {
+	countAllocation();
+	return realloc(ptr, size);
+}
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+int auditedMemalign(void ** ptr, size_t alignment, size_t size) {
+	countAllocation();
+	return posix_memalign(ptr, alignment, size);
+}
+#endif
+
+void allocationAuditMark() {
+	allocations_at_mark = allocationCount();
+}
+
+uint32_t allocationsSinceMark() {
+	return allocationCount() - allocations_at_mark;
+}
+
+uint32_t allocationCount() {
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	return __atomic_load_n(&allocations_made, __ATOMIC_RELAXED);
+#else
+	return allocations_made;
+#endif
+}
+
+#endif
+
 
 };
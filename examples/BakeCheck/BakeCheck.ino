@@ -0,0 +1,203 @@
+/*
+
+ BakeCheck.ino -- Checks baked schedules against live playback, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://flyingcarsandstuff.com/projects/vargb/
+
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ A baked schedule must look exactly like the schedule it was baked from,
+ tick for tick.  This sketch runs two drivers side by side: one playing a
+ schedule with every kind of curve live, the other playing the same
+ schedule baked.  It also seeks a third copy to each tick, with setTick(),
+ and asks the schedule for its valueAt() each tick.  All four must agree,
+ over a few runs (so across the wrap-around, too).  The schedule ends with
+ a couple of large Compiled logic trees, to put those through their paces.
+
+ Requires VaRGB_ENABLE_SCHEDULE_BAKING (the default).  Connect using the
+ serial monitor, at the rate specified by SERIAL_BAUD_RATE, below, for
+ the results.
+*/
+
+#define SERIAL_BAUD_RATE   115200
+
+// how many times to run through the whole schedule
+#define number_of_runs     3
+
+
+/* *** Includes *** */
+
+#include <VaRGB.h>
+#include <VaRGBCurves.h>
+#include <includes/BakedSchedule.h>
+
+
+/* *** Drivers *** */
+
+// each driver simply remembers the last color it was told to set
+vargb::ColorSettings live_color;
+vargb::ColorSettings baked_color;
+vargb::ColorSettings seek_color;
+
+void liveColorCB(vargb::ColorSettings * set_to) { live_color = *set_to; }
+void bakedColorCB(vargb::ColorSettings * set_to) { baked_color = *set_to; }
+void seekColorCB(vargb::ColorSettings * set_to) { seek_color = *set_to; }
+
+vargb::VaRGB live_driver(liveColorCB);
+vargb::VaRGB baked_driver(bakedColorCB);
+vargb::VaRGB seek_driver(seekColorCB);
+
+
+/* *** Schedules *** */
+
+// a logic tree that goes depth levels deep, with a result to keep aside
+// at each level: more than a few levels make for programs with more
+// value slots than a Compiled curve's valueAt() keeps on the stack.
+vargb::Curve::Curve * createDeepTree(uint8_t depth)
+{
+  if (! depth)
+  {
+    return new vargb::Curve::Linear(500, 1000, 200, 3);
+  }
+
+  return new vargb::Curve::OrLogic(
+              new vargb::Curve::Not(new vargb::Curve::Sine(600, 200, 900, 3, 2, 0)),
+              new vargb::Curve::AndLogic(createDeepTree(depth - 1),
+                          new vargb::Curve::Not(new vargb::Curve::Linear(100, 700, 300, 3))));
+}
+
+// the curves can't be shared between schedules (each keeps its own
+// state), so we make a few identical schedules.
+vargb::Schedule * createSchedule()
+{
+  vargb::Schedule * sched = new vargb::Schedule();
+
+  sched->addTransition(new vargb::Curve::Constant(100, 200, 300, 2));
+  sched->addTransition(new vargb::Curve::Linear(900, 10, 300, 3));
+  sched->addTransition(new vargb::Curve::Flasher(500, 600, 700, 4, 5));
+  sched->addTransition(new vargb::Curve::Sine(1000, 500, 250, 3, 1, 90));
+  // zero-length transitions still take up a tick
+  sched->addTransition(new vargb::Curve::Constant(5, 6, 7, 0));
+  sched->addTransition(new vargb::Curve::Linear(0, 300, 0, 2));
+  sched->addTransition(new vargb::Curve::OrLogic(
+                            new vargb::Curve::Flasher(500, 600, 700, 2, 5),
+                            new vargb::Curve::Linear(1000, 0, 20, 2)));
+  sched->addTransition(new vargb::Curve::Not(
+                            new vargb::Curve::Linear(1000, 0, 1000, 2)));
+  // big compiled trees: 22 value slots, then too many to keep on the stack
+  sched->addTransition(new vargb::Curve::Compiled(createDeepTree(4)));
+  sched->addTransition(new vargb::Curve::Compiled(createDeepTree(17)));
+
+  return sched;
+}
+
+vargb::Schedule * live_schedule;
+vargb::Schedule * seek_schedule;
+vargb::BakedSchedule * baked_schedule;
+
+
+bool sameColor(vargb::ColorSettings * a, vargb::ColorSettings * b)
+{
+  return a->red == b->red && a->green == b->green && a->blue == b->blue;
+}
+
+void reportMismatch(const char * what, unsigned long tick, vargb::ColorSettings * got,
+                    vargb::ColorSettings * expected)
+{
+  Serial.print(what);
+  Serial.print(" differs at tick ");
+  Serial.print(tick);
+  Serial.print(": ");
+  Serial.print(got->red); Serial.print(",");
+  Serial.print(got->green); Serial.print(",");
+  Serial.print(got->blue);
+  Serial.print(" instead of ");
+  Serial.print(expected->red); Serial.print(",");
+  Serial.print(expected->green); Serial.print(",");
+  Serial.println(expected->blue);
+}
+
+
+/* *** Arduino functions *** */
+
+void setup()
+{
+  Serial.begin(SERIAL_BAUD_RATE);
+
+  live_schedule = createSchedule();
+  seek_schedule = createSchedule();
+  baked_schedule = new vargb::BakedSchedule(createSchedule());
+  if (! baked_schedule->valid())
+  {
+    Serial.println("Not enough memory to bake the schedule");
+    return;
+  }
+
+  live_driver.setSchedule(live_schedule);
+  baked_driver.setSchedule(baked_schedule);
+  seek_driver.setSchedule(seek_schedule);
+
+  unsigned long total_ticks = live_schedule->totalTicks();
+  unsigned long num_bad = 0;
+  for (unsigned long t = 0; t < number_of_runs * total_ticks; t++)
+  {
+    if (t)
+    {
+      live_driver.tick();
+      baked_driver.tick();
+    }
+
+    seek_schedule->setTick(t % total_ticks);
+
+    vargb::IlluminationSettings value = live_schedule->valueAt(t % total_ticks);
+    vargb::ColorSettings value_color;
+    value_color.red = value.values[vargb_red_idx];
+    value_color.green = value.values[vargb_green_idx];
+    value_color.blue = value.values[vargb_blue_idx];
+
+    if (! sameColor(&baked_color, &live_color))
+    {
+      reportMismatch("baked", t, &baked_color, &live_color);
+      num_bad++;
+    }
+    if (! sameColor(&seek_color, &live_color))
+    {
+      reportMismatch("setTick()", t, &seek_color, &live_color);
+      num_bad++;
+    }
+    if (! sameColor(&value_color, &live_color))
+    {
+      reportMismatch("valueAt()", t, &value_color, &live_color);
+      num_bad++;
+    }
+  }
+
+  Serial.print("Checked ");
+  Serial.print(number_of_runs * total_ticks);
+  Serial.print(" ticks: ");
+  if (num_bad)
+  {
+    Serial.print(num_bad);
+    Serial.println(" mismatches");
+  } else {
+    Serial.println("baked, seeks and valueAt() all match live playback");
+  }
+}
+
+void loop()
+{
+  // nothing left to do
+}
@@ -0,0 +1,156 @@
+/*
+
+ GroupReschedule.ino -- Checks DriverGroup::reschedule() under load, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://flyingcarsandstuff.com/projects/vargb/
+
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ A DriverGroup files each of its drivers in a timer wheel, and
+ reschedule() pulls a driver out and files it again.  Drivers with
+ schedules lasting a few seconds sit in the upper levels of the wheel,
+ and get moved down as it turns, so rescheduling them at random moments
+ gives the wheel a good workout.
+
+ This sketch runs two groups of identical drivers (with batched output,
+ so we can compare their frames).  One is left alone, while drivers in
+ the other get reschedule()d at random, many times per second of
+ (simulated) time.  Since none of the schedules actually change,
+ rescheduling must never change the colors: after every sync(), both
+ frames must be the same.
+
+ Connect using the serial monitor, at the rate specified by
+ SERIAL_BAUD_RATE, below, for the results.
+*/
+
+#define SERIAL_BAUD_RATE   115200
+
+#define number_of_drivers  8
+
+// how many ticks to run (at the default 50 updates per second,
+// 30000 ticks is 10 minutes of simulated time)
+#define number_of_ticks    30000
+
+
+/* *** Includes *** */
+
+#include <VaRGB.h>
+#include <VaRGBCurves.h>
+#include <includes/DriverGroup.h>
+
+
+/* *** Drivers *** */
+
+// with batched output, the drivers' own callbacks are never called
+void unusedColorCB(vargb::ColorSettings * set_to) {}
+
+void frameCB(const vargb::ColorSettings * frame, const uint8_t * dirty_bits,
+             vargb::VaRGBFixtureIndex num_fixtures) {}
+
+vargb::DriverGroup steady_group(number_of_drivers, frameCB);
+vargb::DriverGroup busy_group(number_of_drivers, frameCB);
+
+
+/* *** Schedules *** */
+
+// a few seconds per transition, a little different for each driver
+vargb::Schedule * createSchedule(uint8_t k)
+{
+  vargb::Schedule * sched = new vargb::Schedule();
+
+  sched->addTransition(new vargb::Curve::Constant(100 + k, 200, 300, 2 + k));
+  sched->addTransition(new vargb::Curve::Linear(1000, 0, 500, 3 + (k % 3)));
+  sched->addTransition(new vargb::Curve::Flasher(500, 600, 700, 4, 2));
+  sched->addTransition(new vargb::Curve::Linear(0, k * 10, 0, 5 + k));
+
+  return sched;
+}
+
+
+/* *** Arduino functions *** */
+
+void setup()
+{
+  Serial.begin(SERIAL_BAUD_RATE);
+
+  if (! (steady_group.valid() && busy_group.valid()))
+  {
+    Serial.println("Not enough memory for the groups");
+    return;
+  }
+
+  for (uint8_t i = 0; i < number_of_drivers; i++)
+  {
+    vargb::VaRGB * steady = new vargb::VaRGB(unusedColorCB);
+    vargb::VaRGB * busy = new vargb::VaRGB(unusedColorCB);
+    steady->setSchedule(createSchedule(i));
+    busy->setSchedule(createSchedule(i));
+    steady_group.add(steady);
+    busy_group.add(busy);
+  }
+
+  unsigned long num_bad = 0;
+  unsigned long num_rescheduled = 0;
+  for (unsigned long t = 0; t < number_of_ticks; t++)
+  {
+    steady_group.tick();
+    busy_group.tick();
+
+    if (random(3) == 0)
+    {
+      busy_group.reschedule(random(number_of_drivers));
+      num_rescheduled++;
+    }
+
+    if (random(50) == 0)
+    {
+      steady_group.sync();
+      busy_group.sync();
+      for (uint8_t i = 0; i < number_of_drivers; i++)
+      {
+        const vargb::ColorSettings * steady = &(steady_group.frame()[i]);
+        const vargb::ColorSettings * busy = &(busy_group.frame()[i]);
+        if (steady->red != busy->red || steady->green != busy->green
+            || steady->blue != busy->blue)
+        {
+          Serial.print("driver ");
+          Serial.print(i);
+          Serial.print(" differs at tick ");
+          Serial.println(t);
+          num_bad++;
+        }
+      }
+    }
+  }
+
+  Serial.print("Ran ");
+  Serial.print(number_of_ticks);
+  Serial.print(" ticks with ");
+  Serial.print(num_rescheduled);
+  Serial.print(" reschedules: ");
+  if (num_bad)
+  {
+    Serial.print(num_bad);
+    Serial.println(" mismatches");
+  } else {
+    Serial.println("all frames match");
+  }
+}
+
+void loop()
+{
+  // nothing left to do
+}
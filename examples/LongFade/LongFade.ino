@@ -0,0 +1,155 @@
+/*
+
+ LongFade.ino -- Checks that very long fades end on target, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://flyingcarsandstuff.com/projects/vargb/
+
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Linear curves spread the color change over the transition with an
+ error accumulator, which has to work right up to the longest
+ transition a VaRGBTimeValue can hold.  With the default 16-bit time
+ values, that's a bit over 65000 ticks (about 21 minutes).
+
+ This sketch runs a few fades close to that limit, tick by tick (no
+ actual waiting involved), both as Linear curves and on a VaRGBArray,
+ and checks that each ends exactly on its target color.
+
+ Requires VaRGB_LINEAR_DDA (the default): the original stepping, used
+ when built with VaRGB_NO_LINEAR_DDA, may stop a few units short of the
+ target on fades this long.  Connect using the serial monitor, at the rate specified by
+ SERIAL_BAUD_RATE, below, for the results.
+*/
+
+#define SERIAL_BAUD_RATE   115200
+
+#define number_of_fades    3
+
+
+/* *** Includes *** */
+
+#include <VaRGB.h>
+#include <VaRGBCurves.h>
+#include <includes/VaRGBArray.h>
+
+
+/* *** Fades *** */
+
+// targets and durations (in seconds: 1300 seconds is 65000 ticks, at the
+// default 50 updates per second)
+vargb::VaRGBColorValue fade_targets[number_of_fades][3] = {
+  {1023, 0, 0},
+  {16, 59, 1023},
+  {1000, 1, 999}
+};
+vargb::VaRGBTimeValue fade_seconds[number_of_fades] = {1300, 1310, 1250};
+
+void arrayColorCB(vargb::VaRGBFixtureIndex fixture, vargb::ColorSettings * set_to) {}
+
+vargb::VaRGBArray fixtures(number_of_fades, arrayColorCB);
+
+
+bool checkColor(const char * what, uint8_t fade, vargb::VaRGBColorValue red, vargb::VaRGBColorValue green,
+                vargb::VaRGBColorValue blue)
+{
+  if (red == fade_targets[fade][0] && green == fade_targets[fade][1]
+      && blue == fade_targets[fade][2])
+  {
+    return true;
+  }
+
+  Serial.print(what);
+  Serial.print(" fade ");
+  Serial.print(fade);
+  Serial.print(" ended at ");
+  Serial.print(red); Serial.print(",");
+  Serial.print(green); Serial.print(",");
+  Serial.println(blue);
+  return false;
+}
+
+
+/* *** Arduino functions *** */
+
+void setup()
+{
+  Serial.begin(SERIAL_BAUD_RATE);
+
+#ifndef VaRGB_LINEAR_DDA
+  Serial.println("Built without VaRGB_LINEAR_DDA: fades may not end exactly on target");
+#endif
+
+  if (! fixtures.valid())
+  {
+    Serial.println("Not enough memory for the array");
+    return;
+  }
+
+  uint8_t num_bad = 0;
+  unsigned long longest = 0;
+  for (uint8_t i = 0; i < number_of_fades; i++)
+  {
+    vargb::Curve::Linear fade(fade_targets[i][0], fade_targets[i][1], fade_targets[i][2],
+                              fade_seconds[i]);
+    fade.start();
+    while (! fade.completed())
+    {
+      fade.tick();
+    }
+
+    vargb::IlluminationSettings * at = fade.currentSettings();
+    if (! checkColor("Linear", i, at->values[vargb_red_idx], at->values[vargb_green_idx],
+                     at->values[vargb_blue_idx]))
+    {
+      num_bad++;
+    }
+
+    fixtures.setLinear(i, fade_targets[i][0], fade_targets[i][1], fade_targets[i][2],
+                       fade_seconds[i]);
+    if (fade.target()->transition_ticks > longest)
+    {
+      longest = fade.target()->transition_ticks;
+    }
+  }
+
+  for (unsigned long t = 0; t < longest; t++)
+  {
+    fixtures.tick();
+  }
+
+  for (uint8_t i = 0; i < number_of_fades; i++)
+  {
+    vargb::ColorSettings at;
+    fixtures.currentSettings(i, &at);
+    if (! checkColor("VaRGBArray", i, at.red, at.green, at.blue))
+    {
+      num_bad++;
+    }
+  }
+
+  if (num_bad)
+  {
+    Serial.print(num_bad);
+    Serial.println(" fades missed their target");
+  } else {
+    Serial.println("all fades ended on target");
+  }
+}
+
+void loop()
+{
+  // nothing left to do
+}
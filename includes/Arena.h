@@ -0,0 +1,123 @@
+/*
+
+ Arena.h -- bump allocation for curves and schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Creating every curve with new, and letting schedules grow their
+ transition lists as curves are added, scatters lots of little blocks
+ all over the heap--which fragments it, on small targets, and spreads the
+ objects that get ticked together all over memory, on bigger ones.
+
+ An Arena is a single block of memory--a static buffer you provide, or one
+ allocated in one go--from which curves and schedule transition lists are
+ simply carved off, one after the other:
+
+   uint8_t myArenaSpace[512];
+   vargb::Arena myArena(myArenaSpace, sizeof(myArenaSpace));
+
+   vargb::Schedule mySchedule(&myArena, 3); // room for exactly 3 transitions
+   mySchedule.addTransition(new (myArena) vargb::Curve::Linear(0, 0, 0, 0));
+   mySchedule.addTransition(new (myArena) vargb::Curve::Linear(1000, 0, 0, 5));
+   mySchedule.addTransition(new (myArena) vargb::Curve::Sine(500, 1000, 500, 10, 2));
+
+ new (myArena) returns NULL once the arena is full, and nothing is
+ ever freed individually: reset() releases everything at once (without
+ calling any destructors), for when you're ready to set up something new.
+
+*/
+#ifndef VARGB_ARENA_H_
+#define VARGB_ARENA_H_
+
+#include "VaRGBConfig.h"
+#include "VaRGBPlatform.h"
+
+// every allocation starts on a multiple of this
+#ifndef VaRGB_ARENA_ALIGNMENT
+#if defined(__AVR__)
+#define VaRGB_ARENA_ALIGNMENT		1
+#else
+#define VaRGB_ARENA_ALIGNMENT		8
+#endif
+#endif
+
+// operator new for the arena must return NULL rather than throw when full
+#if __cplusplus >= 201103L
+#define VaRGB_NOTHROW		noexcept
+#else
+#define VaRGB_NOTHROW		throw()
+#endif
+
+namespace vargb {
+
+class Arena {
+public:
+	/*
+	 * Arena constructor
+	 * Carves allocations out of the buffer passed (of size bytes), which must
+	 * remain valid as long as anything allocated from the arena is in use.
+	 */
+	Arena(void * buffer, size_t size);
+
+	/*
+	 * Arena constructor
+	 * Allocates size bytes, in one go, for the arena.  Check valid() afterwards.
+	 */
+	Arena(size_t size);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	~Arena();
+#endif
+
+	bool valid() { return space != NULL;}
+
+	/*
+	 * allocate
+	 * Returns size bytes from the arena or NULL, if there isn't that much left.
+	 */
+	void * allocate(size_t size);
+
+	/*
+	 * reset
+	 * Releases everything allocated so far, all at once.  No destructors are
+	 * called: whatever was allocated simply must not be used anymore.
+	 */
+	void reset() { used_size = 0;}
+
+	size_t capacity() { return space_size;}
+	size_t used() { return used_size;}
+	size_t remaining() { return space_size - used_size;}
+
+private:
+	uint8_t * space;
+	size_t space_size;
+	size_t used_size;
+	bool owns_space;
+};
+
+} /* namespace vargb */
+
+/*
+ * Placement into an arena, i.e.
+ *   new (myArena) SomeCurve(...)
+ */
+void * operator new(size_t size, vargb::Arena & arena) VaRGB_NOTHROW;
+void operator delete(void * ptr, vargb::Arena & arena) VaRGB_NOTHROW;
+
+#endif /* VARGB_ARENA_H_ */
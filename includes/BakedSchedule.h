@@ -0,0 +1,118 @@
+/*
+
+ BakedSchedule.h -- part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+
+ *****************************  OVERVIEW  *****************************
+
+ Most schedules are deterministic loops: every time through, each tick
+ produces exactly the same colors.  Rather than re-computing linear
+ steps, sines and logic combinations live on every tick, you can "bake"
+ such a schedule once--rendering one whole run, totalTicks() frames,
+ into a table of packed colors--and play that back instead.
+
+ A BakedSchedule is a Schedule, so the VaRGB driver runs it like any other:
+
+   vargb::Schedule mySchedule;
+   // ... add all the transitions ...
+
+   vargb::BakedSchedule myBakedSchedule(&mySchedule);
+   if (myBakedSchedule.valid())
+   {
+     myDriver.setSchedule(&myBakedSchedule);
+   }
+
+ after which each tick costs a table lookup.  Once baked, the original
+ schedule (and its curves) are no longer needed.
+
+ The frame table may also be computed elsewhere (e.g. on a host, using
+ BakedSchedule::bake()) and passed in directly.
+
+*/
+
+#ifndef BAKEDSCHEDULE_H_
+#define BAKEDSCHEDULE_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_ENABLE_SCHEDULE_BAKING
+
+#include "VaRGBPlatform.h"
+#include "Schedule.h"
+#include "Curves/Baked.h"
+
+namespace vargb {
+
+class BakedSchedule : public Schedule {
+public:
+
+	/*
+	 * BakedSchedule constructor
+	 * Bakes the source schedule into a newly allocated frame table.  Check
+	 * valid() afterwards, to ensure the memory was available.
+	 */
+	BakedSchedule(Schedule * source, ScheduleID sched_id=0);
+
+	/*
+	 * BakedSchedule constructor
+	 * Plays back an existing frame table, frame_count long.  The table is not
+	 * copied, and must remain valid for the lifetime of the schedule.
+	 */
+	BakedSchedule(const VaRGBPackedColor * frames, VaRGBTimeValue frame_count, ScheduleID sched_id=0);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	~BakedSchedule();
+#endif
+
+	/*
+	 * bake
+	 * Renders one run of the source schedule into the frame table
+	 * passed, which must have space for at least source->totalTicks() entries.
+	 * Returns the number of frames written.
+	 */
+	static VaRGBTimeValue bake(const Schedule * source, VaRGBPackedColor * into);
+
+	/*
+	 * valid
+	 * True if we have a (non-empty) frame table to play.
+	 */
+	bool valid() { return frame_table != NULL && num_frames > 0;}
+
+	/*
+	 * frames/numFrames
+	 * The frame table being played, and its length.
+	 */
+	const VaRGBPackedColor * frames() { return frame_table;}
+	VaRGBTimeValue numFrames() { return num_frames;}
+
+private:
+	const VaRGBPackedColor * frame_table;
+	VaRGBTimeValue num_frames;
+	bool owns_frames;
+
+	Curve::Baked frame_curve;
+
+};
+
+} /* namespace vargb */
+
+// VaRGB_ENABLE_SCHEDULE_BAKING
+#endif
+
+#endif /* BAKEDSCHEDULE_H_ */
@@ -0,0 +1,261 @@
+/*
+
+ BakedShow.h -- compressed, memory-mapped baked shows, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Baked shows are only available on VaRGB_TARGET_PLATFORM_POSIX hosts.
+
+ A BakedSchedule keeps one fixture's frames in RAM.  A whole show--thousands
+ of fixtures, for half an hour--is far too big for that: even packed, 10k
+ fixtures at 50 frames per second is gigabytes.  A baked show file holds
+ every fixture's color for every frame, compressed, and is played back
+ straight from a memory-mapped file.
+
+ Writing a show:
+
+   vargb::BakedShowWriter writer("myshow.vrgb", num_fixtures);
+   for (uint32_t f=0; f < num_frames; f++)
+   {
+     // fill in colors[0 .. num_fixtures-1] for frame f, e.g. using
+     // someSchedule.valueAt(f) for each fixture, then
+     writer.addFrame(colors);
+   }
+   writer.close();
+
+ Playing it back:
+
+   vargb::BakedShow show(myFixtureColorCallback);
+   if (show.open("myshow.vrgb"))
+   {
+     vargb::TickClock clock;
+     while (true) {
+       show.tick(clock.waitForTicks());
+     }
+   }
+
+ The callback is the same kind used by VaRGBArray, and is only invoked for
+ fixtures whose color actually changed.  Opening a show is instant (nothing
+ is read up front) and memory use depends only on the number of fixtures,
+ not on the length of the show.
+
+
+ File format
+ -----------
+
+ All values are in host byte order.  The file starts with a BakedShowHeader,
+ followed by the frames, followed by the keyframe index.
+
+ Each frame is coded relative to the previous one, as a sequence of:
+
+   <skip> <red delta> <green delta> <blue delta>
+
+ where skip is the number of unchanged fixtures before the next changed one
+ and each delta is the (signed) change in that channel's value.  Skips are
+ unsigned LEB128 varints, deltas zigzag-encoded varints, so small changes
+ take a byte.  Decoding a frame starts at fixture 0 and stops once
+ num_fixtures is reached (a final skip covers any trailing unchanged
+ fixtures).  A run of unchanged frames costs one byte each.
+
+ Every keyframe_interval-th frame is a keyframe, coded relative to all-zero
+ colors rather than to the previous frame, so decoding can start there.  The
+ index holds the file offset of each keyframe (num_frames / keyframe_interval,
+ rounded up, uint64_t entries), so seeking to any frame means decoding at
+ most keyframe_interval frames.
+
+*/
+#ifndef BAKEDSHOW_H_
+#define BAKEDSHOW_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <stdio.h>
+#include "VaRGBPlatform.h"
+#include "Curve.h"
+
+// default keyframe spacing, in frames (10 seconds at 50 Hz)
+#define VaRGB_BAKEDSHOW_KEYFRAME_INTERVAL	500
+
+#define VaRGB_BAKEDSHOW_MAGIC				"VaRGBshw"
+#define VaRGB_BAKEDSHOW_VERSION			1
+
+namespace vargb {
+
+/*
+ * Signature for the fixture set-color callback (as for VaRGBArray).  The function must have the form:
+ *
+ * void myfunctionname(vargb::VaRGBFixtureIndex fixture, vargb::ColorSettings * set_colors_to);
+ */
+typedef void (*BakedShow_SetColor_Callback)(VaRGBFixtureIndex fixture, ColorSettings * set_colors_to);
+
+/*
+ * Signature for the show-completed callback, called each time the show
+ * reaches its end (after which it starts over).
+ */
+typedef void (*BakedShow_Completed_Callback)();
+
+
+/*
+ * BakedShowHeader
+ * What's found at the start of every baked show file.
+ */
+typedef struct BakedShowHeaderStruct {
+	char magic[8];
+	uint16_t version;
+	uint16_t header_size;
+	uint32_t num_fixtures;
+	uint32_t num_frames;
+	uint32_t keyframe_interval;
+	uint32_t ms_per_tick;
+	uint32_t reserved;
+	uint64_t index_offset;
+} BakedShowHeader;
+
+
+class BakedShowWriter {
+public:
+	/*
+	 * BakedShowWriter constructor
+	 * Creates (or truncates) the file and prepares to receive frames for
+	 * num_fixtures fixtures.  Check valid() afterwards.
+	 */
+	BakedShowWriter(const char * path, VaRGBFixtureIndex num_fixtures,
+			uint32_t keyframe_interval=VaRGB_BAKEDSHOW_KEYFRAME_INTERVAL);
+
+	~BakedShowWriter();
+
+	bool valid() { return out_file != NULL;}
+
+	/*
+	 * addFrame
+	 * Append the next frame: colors must hold one entry per fixture.
+	 */
+	bool addFrame(const ColorSettings * colors);
+
+	/*
+	 * close
+	 * Writes the index and header, then closes the file.  Returns false if
+	 * anything went wrong along the way.  The show is unusable until closed.
+	 */
+	bool close();
+
+	uint32_t numFrames() { return num_frames;}
+
+private:
+	FILE * out_file;
+	VaRGBFixtureIndex num_fixtures;
+	uint32_t keyframe_interval;
+	uint32_t num_frames;
+	uint64_t offset;
+	bool write_failed;
+
+	ColorSettings * previous;
+	uint64_t * keyframe_offsets;
+	uint32_t keyframe_max;
+
+	bool write(const void * data, size_t len);
+	bool addKeyframeOffset();
+};
+
+
+class BakedShow {
+public:
+	/*
+	 * BakedShow constructor
+	 * Pass the fixture color-setting callback and, optionally, a show-completed
+	 * callback.
+	 */
+	BakedShow(BakedShow_SetColor_Callback set_color_with_cb,
+			BakedShow_Completed_Callback completed_cb=NULL);
+
+	~BakedShow();
+
+	/*
+	 * open
+	 * Maps the show file and positions playback at frame 0 (calling the
+	 * set-color callback for every fixture).  Returns false if the file
+	 * can't be opened or isn't a valid baked show.
+	 */
+	bool open(const char * path);
+
+	/*
+	 * close
+	 * Unmaps the show and releases all memory.
+	 */
+	void close();
+
+	bool valid() { return data != NULL;}
+
+	VaRGBFixtureIndex numFixtures() { return header.num_fixtures;}
+	uint32_t numFrames() { return header.num_frames;}
+	uint32_t currentFrame() { return current_frame;}
+
+	/*
+	 * seek
+	 * Jump to any frame (wrapping around past the end), decoding from the
+	 * closest preceding keyframe.  Fixtures that changed get the callback.
+	 */
+	void seek(uint32_t frame);
+
+	/*
+	 * tick
+	 * Move forward num frames, calling back for each fixture that changed.
+	 * Reaching the end of the show starts it over from the beginning.
+	 */
+	void tick(uint32_t num=1);
+
+	/*
+	 * currentSettings
+	 * Fills the ColorSettings passed with the fixture's current color.
+	 */
+	void currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into);
+
+private:
+	BakedShow_SetColor_Callback set_color_cb;
+	BakedShow_Completed_Callback completed_cb;
+
+	BakedShowHeader header;
+	const uint8_t * data;
+	size_t data_len;
+	const uint8_t * keyframe_index;
+	uint32_t num_keyframes;
+	size_t released_upto; // mapping before this offset has been handed back
+
+	// decoding state
+	const uint8_t * cursor;
+	uint32_t current_frame;
+	ColorSettings * colors;
+	uint8_t * changed; // bitmap of fixtures changed since last dispatch
+
+	bool decodeFrame();
+	bool advanceFrame();
+	bool startAtKeyframe(uint32_t keyframe);
+	void markChanged(VaRGBFixtureIndex fixture) { changed[fixture / 8] |= (1 << (fixture % 8));}
+	void dispatchChanged();
+	void releaseBehind();
+
+};
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
+
+#endif /* BAKEDSHOW_H_ */
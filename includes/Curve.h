@@ -70,7 +70,7 @@ typedef struct IlluminationTargetStruct {
 			VaRGBColorValue blue, VaRGBTimeValue trans_time_seconds = 1);
 
 	VaRGBColorValue values[VaRGB_NUM_COLORS];
-	uint16_t transition_ticks;
+	VaRGBTimeValue transition_ticks;
 
 } IlluminationTarget;
 
@@ -91,6 +91,31 @@ typedef struct ColorSettings {
 } ColorSettings;
 
 
+/*
+ * VaRGBPackedColor
+ * All three color values of a setting squeezed into a single integer, for
+ * when lots of them need to be stored (e.g. baked schedule frame tables).
+ * Each value gets VaRGB_PACKEDCOLOR_BITS bits.
+ */
+#if VaRGB_COLOR_MAXVALUE > 1023
+typedef uint64_t VaRGBPackedColor;
+#define VaRGB_PACKEDCOLOR_BITS		16
+#else
+typedef uint32_t VaRGBPackedColor;
+#define VaRGB_PACKEDCOLOR_BITS		10
+#endif
+
+#define VaRGB_PACKEDCOLOR_MASK		((((VaRGBPackedColor)1) << VaRGB_PACKEDCOLOR_BITS) - 1)
+
+#define VaRGB_PACK_COLOR(r, g, b)	( (((VaRGBPackedColor)(r) & VaRGB_PACKEDCOLOR_MASK) << (2 * VaRGB_PACKEDCOLOR_BITS)) \
+									| (((VaRGBPackedColor)(g) & VaRGB_PACKEDCOLOR_MASK) << VaRGB_PACKEDCOLOR_BITS) \
+									| ((VaRGBPackedColor)(b) & VaRGB_PACKEDCOLOR_MASK) )
+
+#define VaRGB_PACKEDCOLOR_RED(p)		((VaRGBColorValue)(((p) >> (2 * VaRGB_PACKEDCOLOR_BITS)) & VaRGB_PACKEDCOLOR_MASK))
+#define VaRGB_PACKEDCOLOR_GREEN(p)	((VaRGBColorValue)(((p) >> VaRGB_PACKEDCOLOR_BITS) & VaRGB_PACKEDCOLOR_MASK))
+#define VaRGB_PACKEDCOLOR_BLUE(p)	((VaRGBColorValue)((p) & VaRGB_PACKEDCOLOR_MASK))
+
+
 
 #ifdef VaRGB_ENABLE_CURVE_LOGICAL
 // if combos are enabled, we need to be able to
@@ -126,6 +151,10 @@ namespace Curve {
  *
  */
 
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+class Logic; // forward declaration
+#endif
+
 class Curve {
 public:
 	/*
@@ -203,6 +232,7 @@ public:
 	/*
 	 * setTick()
 	 * Similar to start, but used to set the tick count to a non-zero value (move forward in time).
+	 * Always sets the settings_req_update flag, as the settings it lands on are new to the caller.
 	 */
 	virtual void setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings=NULL) = 0;
 
@@ -211,9 +241,41 @@ public:
 	 * Let the curve know that some time has passed.  The curve's job here is to see whether it needs
 	 * to change the current R-G-B settings and/or if it has completed its run and notify the caller
 	 * of each condition using the settings_req_update/curve_completed flags described above.
+	 *
+	 * Advancing by num ticks in one call must cost the same as advancing by one, and
+	 * end up exactly where num single ticks would have.
+	 */
+	virtual void tick(VaRGBTimeValue num=1) = 0;
+
+	/*
+	 * valueAt()
+	 * Returns the illumination settings the curve would report (as currentSettings())
+	 * once start()ed with start_settings and then tick()ed tick times.
+	 *
+	 * Unlike tick(), this has no side effects at all: it doesn't touch the curve's
+	 * state, so it may be called for any point in time, in any order, from any thread.
+	 */
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const = 0;
+
+
+	/*
+	 * ticksRemaining()
+	 * Returns the number of ticks left before this curve completes--it will
+	 * completed() after that many more ticks (or after the next tick, if this is 0).
 	 */
-	virtual void tick(uint8_t num=1) = 0;
+	VARGB_CURVE_VIRTMETHOD_PREFIX VaRGBTimeValue ticksRemaining();
 
+	/*
+	 * ticksUntilNextChange()
+	 * Returns the number of ticks (at least 1) before the curve might next
+	 * change its settings or complete.  Nothing happens on the ticks in
+	 * between, so callers may skip right over them by tick()ing that many at once.
+	 *
+	 * The default is 1 (anything may happen on the next tick); curves override
+	 * it when they know better.
+	 */
+	virtual VaRGBTimeValue ticksUntilNextChange() { return 1; }
 
 	/*
 	 * currentSettings()
@@ -235,15 +297,37 @@ public:
 	 */
 	VARGB_CURVE_VIRTMETHOD_PREFIX void reset();
 
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+	/*
+	 * asLogic()
+	 * Returns this curve as a Logic curve, if it is one, or NULL.
+	 */
+	virtual Logic * asLogic() { return NULL; }
+#endif
+
 protected:
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+	friend class Logic;
+#endif
 
 
+#ifdef VaRGB_COMPACT_LAYOUT
+	bool settings_req_update : 1;
+	bool curve_completed : 1;
+#else
 	bool settings_req_update;
 	bool curve_completed;
+#endif
 	VaRGBTimeValue tick_count;
 	IlluminationTarget curve_target;
 	IlluminationSettings current_settings;
 
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+	// last frame in which a Logic parent tick()ed us (see Logic::tick).
+	// 64 bits, so the frame count never wraps around to alias an old frame.
+	uint64_t tick_frame;
+#endif
+
 
 };
 
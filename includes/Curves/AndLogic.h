@@ -35,12 +35,22 @@ class AndLogic : public Logic {
 public:
 	AndLogic(vargb::Curve::Curve * curve_a, vargb::Curve::Curve * curve_b);
 
+	/*
+	 * AndLogic n-ary constructor
+	 * Combines all num curves in the array passed (up to
+	 * VaRGB_CURVE_LOGIC_MAXCHILDREN), in a single node.
+	 */
+	AndLogic(vargb::Curve::Curve * curves[], uint8_t num);
+
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
 	virtual ~AndLogic() {}
 #endif
 
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
-	virtual void childUpdated();
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const;
 
 };
 
@@ -0,0 +1,77 @@
+/*
+
+ Baked.h -- part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+
+ *****************************  OVERVIEW  *****************************
+
+ A baked curve plays back a table of pre-computed frames--one packed color
+ per tick--so "computing" the current settings is just a table lookup.  It
+ runs for as many ticks as there are frames.
+
+ You'll normally not use this directly, but through a BakedSchedule.
+
+*/
+
+#ifndef BAKEDCURVE_H_
+#define BAKEDCURVE_H_
+
+#include "../Curve.h"
+
+namespace vargb {
+namespace Curve {
+
+
+class Baked : public Curve {
+public:
+	/*
+	 * Baked constructor.
+	 * Pass the frame table and the number of frames (ticks) it holds.  The
+	 * table isn't copied, so must remain valid for the lifetime of the curve.
+	 */
+	Baked(const VaRGBPackedColor * frames=NULL, VaRGBTimeValue num_frames=0);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	virtual ~Baked();
+#endif
+
+	/*
+	 * setFrames()
+	 * Swap in another frame table.  The curve target becomes the last frame.
+	 */
+	void setFrames(const VaRGBPackedColor * frames, VaRGBTimeValue num_frames);
+
+	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL);
+	virtual void tick(VaRGBTimeValue num=1);
+	virtual VaRGBTimeValue ticksUntilNextChange();
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
+private:
+
+	const VaRGBPackedColor * frame_table;
+	VaRGBPackedColor current_frame;
+
+	VaRGBPackedColor frameAt(VaRGBTimeValue tick) const;
+	void setCurrentFrame(VaRGBPackedColor frame);
+
+};
+
+} /* namespace Curve */
+} /* namespace vargb */
+#endif /* BAKEDCURVE_H_ */
@@ -0,0 +1,130 @@
+/*
+
+ Compiled.h -- flattened logic curve trees, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Deep combinations of logic curves--an AND of an OR of a NOT of...--work
+ by recursion: every tick goes down through each Logic to its children,
+ one virtual call at a time, and each combination is then recomputed on
+ the way back up.
+
+ A Compiled curve flattens such a tree, once, into:
+
+   * the list of "leaf" curves (those that actually do something with
+     time: Linear, Sine...), each appearing once however many times it's
+     used in the tree; and
+
+   * a program: one instruction per Logic node, in the order they must be
+     evaluated (children first), each reading the value slots of its
+     operands and writing its own, in a single array.
+
+ Ticking it ticks the leaves then, if any changed, runs the program in a
+ simple loop.  Use it anywhere you'd use the tree itself:
+
+   vargb::Curve::OrLogic myCombo(&aFlasher, new vargb::Curve::Not(&aSine));
+   vargb::Curve::Compiled myCompiledCombo(&myCombo);
+   mySchedule.addTransition(&myCompiledCombo);
+
+ The tree (and its leaves, which the compiled curve ticks) must remain
+ valid as long as the compiled curve is in use, and shouldn't be used
+ elsewhere at the same time.  Logic curves of your own devising work too,
+ their combine() being called from the program.
+
+*/
+#ifndef COMPILEDCURVE_H_
+#define COMPILEDCURVE_H_
+
+#include "../VaRGBConfig.h"
+
+#ifdef VaRGB_ENABLE_CURVE_COMPILEDLOGIC
+
+#include "../Curve.h"
+#include "Logic.h"
+
+// value slots are indexed by uint8_t
+#define VaRGB_COMPILED_MAX_SLOTS		255
+
+// valueAt() keeps the intermediate results of the program on the
+// stack, up to this many at once (which takes uncommonly deep and bushy
+// trees to exceed).  Programs needing more work in the curve's own slots,
+// so their valueAt() mustn't be called while the curve is being ticked
+// from another thread.
+#define VaRGB_COMPILED_STACK_SLOTS		16
+
+namespace vargb {
+namespace Curve {
+
+class Compiled : public Curve {
+public:
+	/*
+	 * Compiled constructor
+	 * Takes a pointer to the (root of the) curve tree to flatten.  Check
+	 * valid() afterwards, to ensure the memory was available and the tree
+	 * wasn't too large (VaRGB_COMPILED_MAX_SLOTS leaves and nodes) or
+	 * holding an invalid Logic curve.
+	 */
+	Compiled(vargb::Curve::Curve * tree);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	virtual ~Compiled();
+#endif
+
+	bool valid() { return slots != NULL;}
+
+	uint8_t numLeaves() { return num_leaves;}
+	uint8_t numInstructions() { return num_instructions;}
+
+	virtual bool completed();
+	virtual VaRGBTimeValue ticksRemaining();
+	virtual VaRGBTimeValue ticksUntilNextChange();
+	virtual void settingsUpdated();
+	virtual void start(IlluminationSettings* initial_settings = NULL);
+	virtual void setTick(VaRGBTimeValue setTo,
+			IlluminationSettings* initial_settings = NULL);
+	virtual void tick(VaRGBTimeValue num = 1);
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
+	virtual void reset();
+
+private:
+	vargb::Curve::Curve ** leaves;
+	LogicInstruction * program;
+	IlluminationSettings * slots; // leaves' values, then each instruction's result
+	uint8_t num_leaves;
+	uint8_t num_instructions;
+	uint8_t result_slot;
+	uint8_t value_depth; // most intermediate results valueAt() holds at once
+
+	bool countNodes(vargb::Curve::Curve * node, uint16_t * num_nodes);
+	void gatherLeaves(vargb::Curve::Curve * node);
+	uint8_t emit(vargb::Curve::Curve * node);
+	void run(IlluminationSettings * with_slots) const;
+	void execute(const LogicInstruction * instr, const IlluminationSettings * operands[],
+			IlluminationSettings * result) const;
+	uint8_t valueDepth() const;
+	void update();
+};
+
+} /* namespace Curve */
+} /* namespace vargb */
+
+#endif /* VaRGB_ENABLE_CURVE_COMPILEDLOGIC */
+
+#endif /* COMPILEDCURVE_H_ */
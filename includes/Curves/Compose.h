@@ -0,0 +1,447 @@
+/*
+
+ Compose.h -- compile-time curve composition, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ The Logic curves (AndLogic, OrLogic, Not...) are assembled at run time,
+ out of pointers to other curves, and everything they do goes through
+ virtual calls.  When a show is fixed at build time, the same combinations
+ may be expressed as types instead:
+
+   typedef vargb::Compose::And<vargb::Curve::Flasher, vargb::Curve::Linear> FlashFade;
+   typedef vargb::Compose::Not<vargb::Compose::Shift<vargb::Curve::Sine> > DimInverse;
+
+   FlashFade myFlashFade(vargb::Curve::Flasher(1023, 1023, 1023, 6, 12),
+   			vargb::Curve::Linear(0, 500, 1023, 6));
+
+ The children are held by value (no heap, no pointers), and every call
+ from a combination to its children is resolved at compile time--the
+ compiler is free to inline the whole tree.  The leaves are the usual
+ Constant, Linear, Flasher and Sine curves, and the combinations behave
+ exactly like their Logic counterparts.
+
+ To use a composition in a Schedule, wrap it in an AsCurve:
+
+   vargb::Compose::AsCurve<FlashFade> myTransition(myFlashFade);
+   mySchedule.addTransition(&myTransition);
+
+ which costs a single virtual call per tick, for the entire tree.
+
+*/
+#ifndef COMPOSECURVE_H_
+#define COMPOSECURVE_H_
+
+#include "../VaRGBConfig.h"
+#include "../Curve.h"
+
+namespace vargb {
+namespace Compose {
+
+/*
+ * Logic
+ * CRTP base for the compile-time combinations: Derived must provide
+ *
+ *   void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+ *   		IlluminationSettings * into) const;
+ *
+ * (b being NULL for unary combinations).  A and B are the types of the children;
+ * B is void for unary combinations.
+ */
+template<class Derived, class A, class B>
+class Logic {
+public:
+	Logic(const A & child_a, const B & child_b) : a(child_a), b(child_b), settings_req_update(false)
+	{
+		// we run until the first child completes
+		logic_target.transition_ticks = a.target()->transition_ticks;
+		if (b.target()->transition_ticks < logic_target.transition_ticks)
+		{
+			logic_target.transition_ticks = b.target()->transition_ticks;
+		}
+	}
+
+	inline IlluminationTarget * target() { return &logic_target;}
+	inline IlluminationSettings * currentSettings() { return &current_settings;}
+	inline bool settingsNeedUpdate() { return settings_req_update;}
+	inline bool completed() { return a.completed() || b.completed();}
+
+	inline void settingsUpdated()
+	{
+		settings_req_update = false;
+		a.settingsUpdated();
+		b.settingsUpdated();
+	}
+
+	inline VaRGBTimeValue ticksRemaining()
+	{
+		VaRGBTimeValue rem_a = a.ticksRemaining();
+		VaRGBTimeValue rem_b = b.ticksRemaining();
+		return rem_a < rem_b ? rem_a : rem_b;
+	}
+
+	inline VaRGBTimeValue ticksUntilNextChange()
+	{
+		VaRGBTimeValue next_a = a.ticksUntilNextChange();
+		VaRGBTimeValue next_b = b.ticksUntilNextChange();
+		return next_a < next_b ? next_a : next_b;
+	}
+
+	inline void reset() { a.reset(); b.reset();}
+
+	inline void start(IlluminationSettings* initial_settings=NULL)
+	{
+		a.start(initial_settings);
+		b.start(initial_settings);
+		settings_req_update = true;
+		update();
+	}
+
+	inline void setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings=NULL)
+	{
+		a.setTick(setTo, initial_settings);
+		b.setTick(setTo, initial_settings);
+		settings_req_update = true;
+		update();
+	}
+
+	inline void tick(VaRGBTimeValue num=1)
+	{
+		a.tick(num);
+		b.tick(num);
+		childrenTicked();
+	}
+
+	inline IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const
+	{
+		IlluminationSettings value_a = a.valueAt(tick, start_settings);
+		IlluminationSettings value_b = b.valueAt(tick, start_settings);
+		IlluminationSettings value;
+		static_cast<const Derived*>(this)->combine(&value_a, &value_b, &value);
+		return value;
+	}
+
+protected:
+	A a;
+	B b;
+	bool settings_req_update;
+	IlluminationTarget logic_target;
+	IlluminationSettings current_settings;
+
+	inline void update()
+	{
+		static_cast<const Derived*>(this)->combine(a.currentSettings(), b.currentSettings(),
+				&current_settings);
+	}
+
+	inline void childrenTicked()
+	{
+		if (a.settingsNeedUpdate() || b.settingsNeedUpdate())
+		{
+			settings_req_update = true;
+		}
+		if (settings_req_update)
+		{
+			update();
+		}
+	}
+};
+
+/*
+ * Logic, unary version: there's a single child, a.
+ */
+template<class Derived, class A>
+class Logic<Derived, A, void> {
+public:
+	Logic(const A & child_a) : a(child_a), settings_req_update(false)
+	{
+		logic_target.transition_ticks = a.target()->transition_ticks;
+	}
+
+	inline IlluminationTarget * target() { return &logic_target;}
+	inline IlluminationSettings * currentSettings() { return &current_settings;}
+	inline bool settingsNeedUpdate() { return settings_req_update;}
+	inline bool completed() { return a.completed();}
+
+	inline void settingsUpdated()
+	{
+		settings_req_update = false;
+		a.settingsUpdated();
+	}
+
+	inline VaRGBTimeValue ticksRemaining() { return a.ticksRemaining();}
+	inline VaRGBTimeValue ticksUntilNextChange() { return a.ticksUntilNextChange();}
+	inline void reset() { a.reset();}
+
+	inline void start(IlluminationSettings* initial_settings=NULL)
+	{
+		a.start(initial_settings);
+		settings_req_update = true;
+		update();
+	}
+
+	inline void setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings=NULL)
+	{
+		a.setTick(setTo, initial_settings);
+		settings_req_update = true;
+		update();
+	}
+
+	inline void tick(VaRGBTimeValue num=1)
+	{
+		a.tick(num);
+		childrenTicked();
+	}
+
+	inline IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const
+	{
+		IlluminationSettings value_a = a.valueAt(tick, start_settings);
+		IlluminationSettings value;
+		static_cast<const Derived*>(this)->combine(&value_a, NULL, &value);
+		return value;
+	}
+
+protected:
+	A a;
+	bool settings_req_update;
+	IlluminationTarget logic_target;
+	IlluminationSettings current_settings;
+
+	inline void update()
+	{
+		static_cast<const Derived*>(this)->combine(a.currentSettings(), NULL, &current_settings);
+	}
+
+	inline void childrenTicked()
+	{
+		if (a.settingsNeedUpdate())
+		{
+			settings_req_update = true;
+		}
+		if (settings_req_update)
+		{
+			update();
+		}
+	}
+};
+
+
+/*
+ * And
+ * Compile-time AndLogic.
+ */
+template<class A, class B>
+class And : public Logic<And<A, B>, A, B> {
+public:
+	And(const A & child_a, const B & child_b) : Logic<And<A, B>, A, B>(child_a, child_b) {}
+
+	inline void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+			IlluminationSettings * into) const
+	{
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			into->values[i] = a->values[i] & b->values[i];
+		}
+	}
+};
+
+/*
+ * Or
+ * Compile-time OrLogic.
+ */
+template<class A, class B>
+class Or : public Logic<Or<A, B>, A, B> {
+public:
+	Or(const A & child_a, const B & child_b) : Logic<Or<A, B>, A, B>(child_a, child_b) {}
+
+	inline void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+			IlluminationSettings * into) const
+	{
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			into->values[i] = a->values[i] | b->values[i];
+		}
+	}
+};
+
+/*
+ * Not
+ * Compile-time Not: inverts the channels selected.
+ */
+template<class A>
+class Not : public Logic<Not<A>, A, void> {
+public:
+	Not(const A & child, bool red_channel=true, bool green_channel=true, bool blue_channel=true) :
+		Logic<Not<A>, A, void>(child)
+	{
+		channel_on[vargb_red_idx] = red_channel;
+		channel_on[vargb_green_idx] = green_channel;
+		channel_on[vargb_blue_idx] = blue_channel;
+	}
+
+	inline void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+			IlluminationSettings * into) const
+	{
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			into->values[i] = channel_on[i] ? (VaRGB_COLOR_MAXVALUE & (~(a->values[i]))) : a->values[i];
+		}
+	}
+
+private:
+	bool channel_on[VaRGB_NUM_COLORS];
+};
+
+/*
+ * Shift
+ * Compile-time Shift, by BITS positions in the direction given (as for
+ * vargb::Curve::Shift, ShiftRight by default).
+ */
+template<class A, uint8_t BITS=1, uint8_t DIRECTION=0>
+class Shift : public Logic<Shift<A, BITS, DIRECTION>, A, void> {
+public:
+	Shift(const A & child) : Logic<Shift<A, BITS, DIRECTION>, A, void>(child) {}
+
+	inline void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+			IlluminationSettings * into) const
+	{
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			// DIRECTION is a vargb::Curve::ShiftDir, 0 being ShiftRight
+			into->values[i] = DIRECTION ? (a->values[i] << BITS) : (a->values[i] >> BITS);
+		}
+	}
+};
+
+/*
+ * Threshold
+ * Compile-time Threshold: values beyond the threshold (above, unless
+ * DIRECTION is 1, i.e. vargb::Curve::ThresholdBelow) pass, others are
+ * replaced by the default value.
+ */
+template<class A, uint8_t DIRECTION=0>
+class Threshold : public Logic<Threshold<A, DIRECTION>, A, void> {
+public:
+	Threshold(const A & child, VaRGBColorValue threshold_value, VaRGBColorValue default_val=0) :
+		Logic<Threshold<A, DIRECTION>, A, void>(child),
+		threshold(threshold_value),
+		default_value(default_val)
+	{
+	}
+
+	inline void combine(const IlluminationSettings * a, const IlluminationSettings * b,
+			IlluminationSettings * into) const
+	{
+		for (uint8_t i = 0; i < VaRGB_NUM_COLORS; i++)
+		{
+			bool passes = DIRECTION ? (a->values[i] < threshold) : (a->values[i] > threshold);
+			into->values[i] = passes ? a->values[i] : default_value;
+		}
+	}
+
+private:
+	VaRGBColorValue threshold;
+	VaRGBColorValue default_value;
+};
+
+
+/*
+ * AsCurve
+ * Wraps a composition (or any curve type, really) so it can be used as a
+ * regular vargb::Curve::Curve, e.g. as a Schedule transition.
+ */
+template<class T>
+class AsCurve : public vargb::Curve::Curve {
+public:
+	AsCurve(const T & tree) : vargb::Curve::Curve(0, 0, 0, 0), composition(tree)
+	{
+		curve_target = *(composition.target());
+	}
+
+	T * composed() { return &composition;}
+
+	virtual void setTick(VaRGBTimeValue setTo, IlluminationSettings* initial_settings=NULL)
+	{
+		acknowledge();
+		if (setTo)
+		{
+			// as schedules do, reset before moving to another point in time
+			composition.reset();
+			composition.setTick(setTo, initial_settings);
+		} else {
+			// (which is how Curve::start() gets here)
+			composition.start(initial_settings);
+		}
+		sync();
+	}
+
+	virtual void tick(VaRGBTimeValue num=1)
+	{
+		acknowledge();
+		composition.tick(num);
+		sync();
+	}
+
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const
+	{
+		return composition.valueAt(tick, start_settings);
+	}
+
+	virtual VaRGBTimeValue ticksUntilNextChange()
+	{
+		return composition.ticksUntilNextChange();
+	}
+
+#ifdef VaRGB_ENABLE_CURVE_LOGICAL
+	// these are only virtual with logical curves enabled; otherwise, the base
+	// class versions work from the flags sync() maintains.
+	virtual VaRGBTimeValue ticksRemaining() { return composition.ticksRemaining();}
+#endif
+
+private:
+	T composition;
+
+	// the settings_req_update flag is cleared by our user, through the base class
+	inline void acknowledge()
+	{
+		if (! settings_req_update && composition.settingsNeedUpdate())
+		{
+			composition.settingsUpdated();
+		}
+	}
+
+	inline void sync()
+	{
+		IlluminationSettings * settings = composition.currentSettings();
+		current_settings.values[vargb_red_idx] = settings->values[vargb_red_idx];
+		current_settings.values[vargb_green_idx] = settings->values[vargb_green_idx];
+		current_settings.values[vargb_blue_idx] = settings->values[vargb_blue_idx];
+		settings_req_update = composition.settingsNeedUpdate();
+		curve_completed = composition.completed();
+		tick_count = curve_target.transition_ticks - composition.ticksRemaining();
+	}
+};
+
+} /* namespace Compose */
+} /* namespace vargb */
+
+#endif /* COMPOSECURVE_H_ */
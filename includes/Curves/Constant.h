@@ -44,7 +44,10 @@ public:
 
 
 	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL);
-	virtual void tick(uint8_t num=1);
+	virtual void tick(VaRGBTimeValue num=1);
+	virtual VaRGBTimeValue ticksUntilNextChange();
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
 private:
 
 };
@@ -22,12 +22,12 @@
  *****************************  OVERVIEW  *****************************
  A Dummy curves does absolutely nothing.
 
- It is used by the Logic curve base class for instances where the derived
- implementation class only operates on a single curve, in order to keep the
- code identical for single- (like Not) or dual-curve (like And) operators.
+ It used to fill in for the missing second child of single-curve Logic
+ operators (like Not), back when every Logic had exactly two.  Logic curves
+ now hold however many children they actually have, so nothing in the
+ library uses it anymore; it's kept for any code of your own that does.
 
- Dummy curves never require an update and never complete.  They are for
- internal use, please ignore.
+ Dummy curves never require an update and never complete.
 
 */
 
@@ -40,7 +40,7 @@ namespace vargb {
 namespace Curve {
 
 
-/* Dummy curve never completes, never completes, doesn't do anything -- used by "not" combo. */
+/* Dummy curve never completes and doesn't do anything -- a placeholder, not used by the library itself. */
 class Dummy : public Curve {
 public:
 	Dummy();
@@ -51,9 +51,13 @@ public:
 
 
 	VARGB_CURVE_VIRTORINLINE_METHOD_PREFIX bool completed() { return false; }
+	VARGB_CURVE_VIRTMETHOD_PREFIX VaRGBTimeValue ticksRemaining() { return VaRGB_TIMEVALUE_MAX; }
+	virtual VaRGBTimeValue ticksUntilNextChange() { return VaRGB_TIMEVALUE_MAX; }
 
 	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL) {}
-	virtual void tick(uint8_t num=1) {}
+	virtual void tick(VaRGBTimeValue num=1) {}
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const { return IlluminationSettings(); }
 
 private:
 
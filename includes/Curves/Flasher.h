@@ -68,15 +68,20 @@ public:
 
 
 	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL);
-	virtual void tick(uint8_t num=1);
+	virtual void tick(VaRGBTimeValue num=1);
+	virtual VaRGBTimeValue ticksUntilNextChange();
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
 private:
 
 	uint8_t num_flashes;
-	VaRGBTimeValue toggle_interval;
 	bool is_flashing;
+	VaRGBTimeValue toggle_interval;
 
 	IlluminationSettings base_settings;
 
+	VaRGBTimeValue toggleInterval() const;
+
 
 };
 
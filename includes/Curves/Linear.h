@@ -60,6 +60,16 @@ namespace vargb {
 namespace Curve {
 
 
+/*
+ * VaRGBColorDelta
+ * A (signed) change in color value, never more than the full range.
+ */
+#ifdef VaRGB_COMPACT_LAYOUT
+typedef int16_t VaRGBColorDelta;
+#else
+typedef int VaRGBColorDelta;
+#endif
+
 /*
  * IlluminationDelta
  * Used internally to record how to progress along the linear
@@ -67,8 +77,19 @@ namespace Curve {
  */
 typedef struct IlluminationDeltaStruct {
 
-	int increments[VaRGB_NUM_COLORS];
+#ifdef VaRGB_LINEAR_DDA
+	// every tick, each channel moves by its whole increment, and its
+	// error accumulates the remainder (in 1/period units)--whenever it
+	// reaches the period, the channel moves one extra step.
+	VaRGBColorDelta increments[VaRGB_NUM_COLORS];
+	int8_t steps[VaRGB_NUM_COLORS];
+	VaRGBTimeValue remainders[VaRGB_NUM_COLORS];
+	VaRGBTimeValue errors[VaRGB_NUM_COLORS];
+	VaRGBTimeValue period;
+#else
+	VaRGBColorDelta increments[VaRGB_NUM_COLORS];
 	VaRGBTimeValue delays[VaRGB_NUM_COLORS];
+#endif
 
 
 } IlluminationDelta;
@@ -92,12 +113,26 @@ public:
 
 
 	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL);
-	virtual void tick(uint8_t num=1);
+	virtual void tick(VaRGBTimeValue num=1);
+	virtual VaRGBTimeValue ticksUntilNextChange();
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
+
+	/*
+	 * calcDelta class method
+	 * Figures out how each color channel should progress to get from start_target to
+	 * end_target in end_target->transition_ticks (see VaRGB_LINEAR_DDA).  Results
+	 * are stored in the delta passed.  Used internally, and by VaRGBArray.
+	 */
+	static void calcDelta(const IlluminationTarget* start_target, const IlluminationTarget* end_target,
+			IlluminationDelta* delta);
 private:
 	IlluminationDelta delta;
 
+#ifdef VaRGB_LINEAR_DDA
+	void advance(VaRGBTimeValue num);
+#endif
 
-	void calcDelta(IlluminationTarget* start_target, IlluminationTarget* end_target);
 
 };
 
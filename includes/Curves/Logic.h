@@ -32,11 +32,21 @@
  Now additional derivatives exist, such as Shift and Threshold, but
  whatevs.
 
- Logic curves need at least one, or optionally two, curves on which to operate.
- These are stored in the (protected member) curves[].  The methods are constructed
- to always check both children for required updates etc, so in cases where you
- are only operating on a single child curve, the second curve is a static Dummy
- curve, which basically never requires an update and never terminates.
+ Logic curves need at least one curve on which to operate, and may have up to
+ VaRGB_CURVE_LOGIC_MAXCHILDREN (see config).  These are stored in the (protected
+ member) curves[], num_curves of them, and only those are ever ticked, checked
+ for updates etc: unary curves (Not, Shift...) have a single child, while AND
+ and OR may combine any number of curves in a single node:
+
+   vargb::Curve::Curve * layers[] = {&aFlasher, &aSine, &aLinear};
+   vargb::Curve::OrLogic myCombo(layers, 3);
+
+ A curve may be the child of more than one logic curve--a single Sine feeding
+ both an AndLogic and an OrLogic, say--so long as they're all part of the same
+ combination (i.e. ticked through the same top-level curve).  Each tick of that
+ top-level curve is a "frame", and every curve below it is tick()ed at most once
+ per frame, however many parents it has: shared curves stay in step with the
+ rest, and expensive ones are only computed once.
 */
 
 #ifndef LOGIC_H_
@@ -45,12 +55,43 @@
 #include "../VaRGBConfig.h"
 #include "../Curve.h"
 
-#include "Dummy.h"
-
 namespace vargb {
 namespace Curve {
 
-#define VARGB_CURVE_LOGIC_NUMCURVES		2
+#define VARGB_CURVE_LOGIC_NUMCURVES		VaRGB_CURVE_LOGIC_MAXCHILDREN
+
+class Logic; // forward declaration
+
+/*
+ * LogicOpcode
+ * What a Logic curve does to its children's settings, as described by
+ * Logic::describe() (used to flatten logic trees, see Compiled).
+ */
+typedef enum LogicOpcodeEnum {
+	LogicOpCustom=0, // anything else: the node's combine() does the job
+	LogicOpAnd,
+	LogicOpOr,
+	LogicOpNot,
+	LogicOpShiftLeft,
+	LogicOpShiftRight,
+	LogicOpThresholdAbove,
+	LogicOpThresholdBelow
+} LogicOpcode;
+
+/*
+ * LogicInstruction
+ * A single logic operation: opcode, operand value slots and parameters.
+ */
+typedef struct LogicInstructionStruct {
+	uint8_t opcode;
+	uint8_t num_operands;
+	uint8_t operands[VARGB_CURVE_LOGIC_NUMCURVES];
+	uint8_t channels; // channel mask (bit i for color i), for LogicOpNot
+	VaRGBColorValue value; // shift bits or threshold
+	VaRGBColorValue alt_value; // threshold default value
+	const Logic * node; // for LogicOpCustom
+} LogicInstruction;
+
 
 class Logic : public vargb::Curve::Curve {
 public:
@@ -60,36 +101,93 @@ public:
 	 */
 	Logic(vargb::Curve::Curve * curve_a, vargb::Curve::Curve * curve_b=NULL);
 
+	/*
+	 * Logic Curve constructor
+	 * Takes an array of num pointers to the curves on which to operate, from
+	 * 1 to VaRGB_CURVE_LOGIC_MAXCHILDREN of them.  Check valid() afterwards:
+	 * any other number of children (or a NULL child) leaves the curve
+	 * without any, to complete immediately, all dark.
+	 */
+	Logic(vargb::Curve::Curve * children[], uint8_t num);
+
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
 	virtual ~Logic() {}
 #endif
 
 	virtual bool completed();
+	virtual VaRGBTimeValue ticksRemaining();
+	virtual VaRGBTimeValue ticksUntilNextChange();
 	virtual void settingsUpdated();
 	virtual void start(IlluminationSettings* initial_settings = NULL);
 	virtual void setTick(VaRGBTimeValue setTo,
 			IlluminationSettings* initial_settings = NULL);
-	virtual void tick(uint8_t num = 1);
+	virtual void tick(VaRGBTimeValue num = 1);
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
 
 
 	virtual void reset();
 
+	virtual Logic * asLogic() { return this; }
+
+	/*
+	 * valid()
+	 * Whether the curve got a usable set of children on construction.
+	 */
+	bool valid() const { return num_curves > 0; }
+
+	/*
+	 * numChildren()/child()
+	 * The curves this one operates on.
+	 */
+	uint8_t numChildren() const { return num_curves; }
+	vargb::Curve::Curve * child(uint8_t idx) const { return curves[idx]; }
+
+	/*
+	 * describe()
+	 * Fills in the opcode and parameters of the instruction passed with
+	 * whatever this curve does to its children (operands are left alone).
+	 * The default is LogicOpCustom, so that curves deriving from Logic
+	 * elsewhere still work when flattened.
+	 */
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
+	friend class Compiled;
+
 	/*
 	 * childUpdated()
 	 * This base class will check the children to see if they've been updated
 	 * after every tick.  If this happens to be the case, the childUpdated()
-	 * method will be called so the Logic curve instance can do its thing.
+	 * method will be called, which combine()s the children's current settings
+	 * into our own.
+	 */
+	virtual void childUpdated();
+
+	/*
+	 * combine()
+	 * Combine the children's settings--child_settings[i] being those of curves[i],
+	 * for i < num_curves--into the settings passed.  This is where the Logic curve instance does its
+	 * thing.  It is used both when ticking and for valueAt(), so must only depend
+	 * on the settings passed and the curve's configuration.
 	 *
 	 * This is an abstract method, which you must override in any derived classes.
 	 */
-	virtual void childUpdated() = 0;
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const = 0;
 
 	vargb::Curve::Curve * curves[VARGB_CURVE_LOGIC_NUMCURVES];
+	uint8_t num_curves;
 
 
 private:
-	static Dummy dummy_curve;
+	bool setChildren(vargb::Curve::Curve * children[], uint8_t num);
+
+	// frame bookkeeping, for children with many parents (see tick()): the
+	// number of frames started by all threads, and the one this thread's in
+	static uint64_t frames_started;
+	static VaRGB_THREAD_LOCAL uint64_t current_frame;
+	static VaRGB_THREAD_LOCAL uint8_t tick_depth;
 
 
 };
@@ -56,8 +56,11 @@ public:
 	virtual ~NotLogic() {}
 #endif
 
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
-	virtual void childUpdated();
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const;
 
 private:
 
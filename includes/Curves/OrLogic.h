@@ -23,6 +23,7 @@
 
  A "OrLogic" curve is a variant of Logic curve, which combines two other
  curves using a bit-wise OR on each of the R, G and B components.
+ More than two may be combined at once, using the n-ary constructor.
 
 
 */
@@ -44,12 +45,22 @@ public:
 	OrLogic(vargb::Curve::Curve * curve_a,
 			vargb::Curve::Curve * curve_b);
 
+	/*
+	 * OrLogic n-ary constructor
+	 * Combines all num curves in the array passed (up to
+	 * VaRGB_CURVE_LOGIC_MAXCHILDREN), in a single node.
+	 */
+	OrLogic(vargb::Curve::Curve * curves[], uint8_t num);
+
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
 	virtual ~OrLogic() {}
 #endif
 
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
-	virtual void childUpdated();
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const;
 
 };
 
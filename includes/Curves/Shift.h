@@ -87,8 +87,11 @@ public:
 	virtual ~Shift() {}
 #endif
 
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
-	virtual void childUpdated();
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const;
 
 private:
 
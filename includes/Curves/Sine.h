@@ -44,6 +44,20 @@
 namespace vargb {
 namespace Curve {
 
+#ifdef VaRGB_SINE_LUT
+// fraction of the target values, in 1/65536 units (0 to 65536)
+typedef uint32_t SineFactor;
+// phase advance per tick, in 1/2^32 of a cycle
+typedef uint32_t SinePhaseStep;
+// phase, in 1/65536 of a cycle
+typedef uint16_t SinePhase;
+#else
+// fraction of the target values (0 to 1)
+typedef double SineFactor;
+// phase advance per tick, and phase, in radians
+typedef float SinePhaseStep;
+typedef float SinePhase;
+#endif
 
 class Sine : public Curve {
 public:
@@ -67,17 +81,40 @@ public:
 
 
 	virtual void setTick(VaRGBTimeValue setTo,  IlluminationSettings* initial_settings=NULL);
-	virtual void tick(uint8_t num=1);
-private:
+	virtual void tick(VaRGBTimeValue num=1);
+	virtual IlluminationSettings valueAt(VaRGBTimeValue tick,
+			const IlluminationSettings* start_settings=NULL) const;
 
-	VaRGBTimeValue ticks_per_cycle;
-	float increment_per_tick;
-	float radians_current;
-	float phase_adjustment;
+	/*
+	 * sinFactorAt class method
+	 * Returns the fraction of the target values at which a sine curve sits
+	 * when its tick count is tick_count.  The phase is always derived from
+	 * the tick count itself, so no error accumulates over long runs.
+	 */
+	static SineFactor sinFactorAt(VaRGBTimeValue tick_count, VaRGBTimeValue ticks_per_cycle,
+			SinePhaseStep increment_per_tick, SinePhase phase_adjustment);
 
+	/*
+	 * phaseStepFor/phaseFor/scaleBy class methods
+	 * Helpers for setting up and applying sinFactorAt(), shared with VaRGBArray.
+	 */
+	static SinePhaseStep phaseStepFor(VaRGBTimeValue ticks_per_cycle);
+	static SinePhase phaseFor(uint16_t phase_degrees);
+	static inline VaRGBColorValue scaleBy(VaRGBColorValue value, SineFactor factor)
+	{
+#ifdef VaRGB_SINE_LUT
+		return ((uint32_t)value * factor) >> 16;
+#else
+		return value * factor;
+#endif
+	}
+private:
 
-	IlluminationSettings base_settings;
+	VaRGBTimeValue ticks_per_cycle;
+	SinePhaseStep increment_per_tick;
+	SinePhase phase_adjustment;
 
+	void updateValues();
 
 };
 
@@ -75,8 +75,11 @@ public:
 	virtual ~Threshold() {}
 #endif
 
+	virtual void describe(LogicInstruction * into) const;
+
 protected:
-	virtual void childUpdated();
+	virtual void combine(const IlluminationSettings * child_settings[],
+			IlluminationSettings * into) const;
 
 private:
 
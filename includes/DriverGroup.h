@@ -0,0 +1,225 @@
+/*
+
+ DriverGroup.h -- timer-wheel scheduling of many VaRGB drivers, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ When you're running a bunch of independent VaRGB drivers (as in the
+ MultiDriver example), tick()ing every one of them on every tick gets
+ expensive as their numbers grow--especially since, on most ticks, most
+ of them have nothing to do.
+
+ A DriverGroup holds any number of drivers and tick()s them for you.  Each
+ driver is filed in a (hierarchical) timer wheel under the tick at which
+ its schedule next changes the colors (see VaRGB::ticksUntilNextChange()).
+ On every group tick(), only the drivers that are due get touched: they
+ are caught up on all the ticks they skipped, in one go, and re-filed under
+ their next change.  The cost of a tick thus depends on the number of
+ drivers actually changing, not on the total number of drivers.
+
+   vargb::DriverGroup myGroup(2);
+   myGroup.add(&myFirstDriver);
+   myGroup.add(&mySecondDriver);
+
+   void loop() {
+     myGroup.tickAndDelay();
+   }
+
+ Batched output
+ --------------
+
+ Pushing one SPI/DMX frame per tick is easier than gathering thousands of
+ single-fixture callbacks.  Create the group with a frame callback instead:
+
+   void myFrameCallback(const vargb::ColorSettings * frame,
+   			const uint8_t * dirty_bits, vargb::VaRGBFixtureIndex num_fixtures)
+   {
+     // frame[i] is the color of the group's driver number i,
+     // VaRGB_FRAME_DIRTY(dirty_bits, i) is true if it changed since the last frame
+   }
+
+   vargb::DriverGroup myGroup(1000, myFrameCallback);
+
+ The drivers added then write straight into the group's frame buffer (their
+ own set-color callbacks are no longer called), and the frame callback is
+ invoked once at the end of every tick().  The dirty bitset is cleared after
+ each frame.
+
+ Since skipped ticks are only delivered when a driver is due, a driver's
+ tickCount() may lag behind between changes--use sync() if you need every
+ driver to be up to date.  If you change a driver's schedule outside of
+ its callbacks, call reschedule() so the group knows about it.
+
+*/
+#ifndef DRIVERGROUP_H_
+#define DRIVERGROUP_H_
+
+#include "../VaRGB.h"
+
+// the wheel: VaRGB_DRIVERGROUP_WHEEL_LEVELS levels of 2^VaRGB_DRIVERGROUP_WHEEL_BITS
+// slots each, which must cover any VaRGBTimeValue
+#define VaRGB_DRIVERGROUP_WHEEL_BITS		6
+#define VaRGB_DRIVERGROUP_WHEEL_LEVELS	((VaRGB_TIMEVALUE_BITS + VaRGB_DRIVERGROUP_WHEEL_BITS - 1) / VaRGB_DRIVERGROUP_WHEEL_BITS)
+#define VaRGB_DRIVERGROUP_WHEEL_SLOTS		(1 << VaRGB_DRIVERGROUP_WHEEL_BITS)
+
+#define VaRGB_DRIVERGROUP_INVALID_INDEX	((vargb::VaRGBFixtureIndex)-1)
+
+// test a fixture's bit in the frame callback's dirty bitset
+#define VaRGB_FRAME_DIRTY(bits, fixture)	((bits)[(fixture) / 8] & (1 << ((fixture) % 8)))
+
+namespace vargb {
+
+/*
+ * Signature for the end-of-frame callback.  The function must have the form:
+ *
+ * void myframecb(const vargb::ColorSettings * frame, const uint8_t * dirty_bits,
+ * 		vargb::VaRGBFixtureIndex num_fixtures);
+ */
+typedef void (*DriverGroup_Frame_Callback)(const ColorSettings * frame, const uint8_t * dirty_bits,
+		VaRGBFixtureIndex num_fixtures);
+
+class DriverGroup {
+public:
+	/*
+	 * DriverGroup constructor
+	 * Pass the maximum number of drivers the group will hold and, for batched
+	 * output, the end-of-frame callback.  Check valid() after construction, to
+	 * ensure all required memory was available.
+	 */
+	DriverGroup(VaRGBFixtureIndex max_drivers, DriverGroup_Frame_Callback frame_cb=NULL);
+
+	/*
+	 * DriverGroup constructor
+	 * Batched output into a frame buffer and dirty bitset (for max_drivers
+	 * fixtures) that belong to someone else, who is responsible for sending
+	 * the frame and clearing the dirty bits (see ParallelGroup).
+	 */
+	DriverGroup(VaRGBFixtureIndex max_drivers, ColorSettings * frame_into, uint8_t * dirty_bits_into);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	~DriverGroup();
+#endif
+
+	bool valid() { return drivers != NULL;}
+
+	/*
+	 * add
+	 * Adds a driver (which should already have its schedule) to the group.
+	 * Returns the driver's index within the group, or
+	 * VaRGB_DRIVERGROUP_INVALID_INDEX if the group is full.
+	 */
+	VaRGBFixtureIndex add(VaRGB * driver);
+
+	VaRGBFixtureIndex numDrivers() { return num_drivers;}
+	VaRGB * driver(VaRGBFixtureIndex idx) { return drivers[idx];}
+
+	/*
+	 * frame/dirtyBits
+	 * The frame buffer and dirty bitset, when using batched output (NULL otherwise).
+	 */
+	const ColorSettings * frame() { return frame_buffer;}
+	const uint8_t * dirtyBits() { return dirty_bits;}
+
+	/*
+	 * reschedule
+	 * Brings the driver up to date and re-files it according to its next
+	 * change.  Call this after changing the driver's schedule yourself (changes
+	 * made from within the driver's own callbacks are noticed automatically).
+	 */
+	void reschedule(VaRGBFixtureIndex idx);
+
+	/*
+	 * sync
+	 * Delivers all pending ticks to every driver, so their tickCount()s are
+	 * current.  Touches every driver, so only use it when you need to.
+	 */
+	void sync();
+
+	/*
+	 * tick
+	 * Advance the group by num ticks, tick()ing the drivers that are due.
+	 */
+	void tick(VaRGBTimeValue num=1);
+
+	/*
+	 * tickAndDelay
+	 * Convenience function to tick() and delay VaRGB::tickDelayTimeMs() millis.
+	 */
+	void tickAndDelay(VaRGBTimeValue num=1);
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	/*
+	 * tickAndWait
+	 * Sleeps until the clock says the next tick is due, then tick()s by however
+	 * many ticks have elapsed (see VaRGB::tickAndWait).
+	 */
+	void tickAndWait(TickClock * clock);
+#endif
+
+	/*
+	 * currentTick
+	 * Number of ticks since the group was created.
+	 */
+	VaRGBTickCount currentTick() { return now;}
+
+	/*
+	 * numTouched
+	 * How many drivers were tick()ed during the last tick, for the curious.
+	 */
+	VaRGBFixtureIndex numTouched() { return num_touched;}
+
+private:
+	VaRGBFixtureIndex max_drivers;
+	VaRGBFixtureIndex num_drivers;
+	VaRGBFixtureIndex num_touched;
+	VaRGBTickCount now;
+
+	// batched output
+	DriverGroup_Frame_Callback frame_cb;
+	ColorSettings * frame_buffer;
+	uint8_t * dirty_bits;
+	bool owns_frame;
+
+	// per-driver state
+	VaRGB ** drivers;
+	VaRGBTickCount * due_tick;
+	VaRGBTickCount * synced_tick;
+	VaRGBFixtureIndex * next_entry;
+	VaRGBFixtureIndex * prev_entry;
+	// the wheel slot (list head) each driver was filed under, as the
+	// slot its due tick maps to changes as the wheel turns
+	VaRGBFixtureIndex ** entry_slot;
+
+	// each wheel slot is a doubly-linked list of driver indices
+	VaRGBFixtureIndex wheel[VaRGB_DRIVERGROUP_WHEEL_LEVELS][VaRGB_DRIVERGROUP_WHEEL_SLOTS];
+
+	VaRGBFixtureIndex * slotFor(VaRGBTickCount due);
+	void insert(VaRGBFixtureIndex idx);
+	void unlink(VaRGBFixtureIndex idx);
+	void catchUp(VaRGBFixtureIndex idx);
+	void cascade(uint8_t level);
+	void tickOnce();
+	void sendFrame();
+	void allocate();
+
+};
+
+} /* namespace vargb */
+
+#endif /* DRIVERGROUP_H_ */
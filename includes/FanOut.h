@@ -0,0 +1,165 @@
+/*
+
+ FanOut.h -- one schedule driving many fixtures, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Chases and waves across a strip are just the same schedule playing on
+ every pixel, each a little ahead of (or behind) its neighbour.  Rather
+ than giving every pixel its own schedule and curves, a FanOut runs a
+ single schedule for all of them: each fixture only has a tick offset
+ (and, optionally, a time scale) and the colors it last got.
+
+   void myPixelCallback(vargb::VaRGBFixtureIndex fixture,
+   			vargb::ColorSettings * set_to)
+   {
+     // ... set the color of pixel number 'fixture'
+   }
+
+   vargb::FanOut myStrip(&mySchedule, 300, myPixelCallback);
+   myStrip.spreadOffsets(4); // pixel i runs 4*i ticks ahead: a chase
+   myStrip.start(); // show where each pixel begins
+
+   void loop() {
+     myStrip.tickAndDelay();
+   }
+
+ Time scales are fixed-point, VaRGB_FANOUT_SCALE_ONE being normal speed,
+ half that half-speed, and so on.  The schedule is only ever read (using
+ Schedule::valueAt()), so it may be shared with other FanOuts or
+ ScheduleCursors.  On each tick, every fixture is evaluated in one pass and
+ the callback invoked for those whose color changed.
+
+*/
+#ifndef FANOUT_H_
+#define FANOUT_H_
+
+#include "VaRGBConfig.h"
+#include "VaRGBPlatform.h"
+#include "Schedule.h"
+
+// time scales are in 1/256ths
+#define VaRGB_FANOUT_SCALE_ONE		256
+
+namespace vargb {
+
+/*
+ * Signature for the fixture set-color callback (as for VaRGBArray).  The function must have the form:
+ *
+ * void myfunctionname(vargb::VaRGBFixtureIndex fixture, vargb::ColorSettings * set_colors_to);
+ */
+typedef void (*FanOut_SetColor_Callback)(VaRGBFixtureIndex fixture, ColorSettings * set_colors_to);
+
+
+class FanOut {
+public:
+	/*
+	 * FanOut constructor
+	 * Pass the schedule to play, the number of fixtures and the color-setting
+	 * callback.  All offsets start at 0.  Check valid() after construction.
+	 */
+	FanOut(const Schedule * sched, VaRGBFixtureIndex num_fixtures, FanOut_SetColor_Callback set_color_with_cb);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	~FanOut();
+#endif
+
+	bool valid() { return offsets != NULL;}
+
+	VaRGBFixtureIndex numFixtures() { return num_fixtures;}
+
+	/*
+	 * setSchedule
+	 * Play another schedule (from the start), keeping the offsets and scales.
+	 * Every fixture's color is sent on start() or the next tick().
+	 */
+	void setSchedule(const Schedule * sched);
+
+	/*
+	 * start
+	 * Sends every fixture its color at the start of the schedule (its offset,
+	 * really) right away.  Call once the offsets and scales are set; if you
+	 * don't, the first tick() does this instead of moving along.
+	 */
+	void start();
+
+	/*
+	 * setOffset
+	 * How many ticks ahead of the others this fixture runs.
+	 */
+	void setOffset(VaRGBFixtureIndex fixture, VaRGBTimeValue offset) { offsets[fixture] = offset;}
+
+	/*
+	 * spreadOffsets
+	 * Convenience: sets every fixture's offset to step times its index.
+	 */
+	void spreadOffsets(VaRGBTimeValue step);
+
+	/*
+	 * setScale
+	 * This fixture's speed, in 1/VaRGB_FANOUT_SCALE_ONE.  The first call
+	 * allocates the scales (all normal speed), and returns false if it can't.
+	 */
+	bool setScale(VaRGBFixtureIndex fixture, uint16_t scale);
+
+	/*
+	 * currentSettings
+	 * Fills the ColorSettings passed with the fixture's current color.
+	 */
+	void currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into);
+
+	/*
+	 * tick
+	 * Move the schedule along num ticks, updating every fixture.
+	 */
+	void tick(VaRGBTimeValue num=1);
+
+	/*
+	 * tickAndDelay
+	 * Convenience function to tick() and delay VaRGB::tickDelayTimeMs() millis.
+	 */
+	void tickAndDelay(VaRGBTimeValue num=1);
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	/*
+	 * tickAndWait
+	 * Sleeps until the clock says the next tick is due, then tick()s by however
+	 * many ticks have elapsed (see VaRGB::tickAndWait).
+	 */
+	void tickAndWait(TickClock * clock);
+#endif
+
+private:
+	const Schedule * schedule;
+	VaRGBFixtureIndex num_fixtures;
+	FanOut_SetColor_Callback set_color_cb;
+	VaRGBTimeProduct position;
+	bool refresh_all; // not start()ed yet: call back for every fixture on the next tick
+
+	// per-fixture state
+	VaRGBTimeValue * offsets;
+	uint16_t * scales; // NULL until some fixture gets a scale
+	VaRGBPackedColor * last_colors;
+
+	void update(bool force);
+};
+
+} /* namespace vargb */
+
+#endif /* FANOUT_H_ */
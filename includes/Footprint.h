@@ -0,0 +1,88 @@
+/*
+
+ Footprint.h -- memory used by curves and schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ With thousands of fixtures, what each one costs in memory decides how
+ many fit in RAM--and in cache.  The footprint report tells you, for the
+ configuration you've built with (see VaRGB_COMPACT_LAYOUT), how many
+ bytes each curve type takes and what a given schedule uses:
+
+   for (uint8_t i = 0; i < vargb::Footprint::numCurveTypes(); i++) {
+     vargb::Footprint::Entry entry = vargb::Footprint::curveType(i);
+     // entry.name, entry.bytes
+   }
+
+   size_t sched_bytes = vargb::Footprint::schedule(&mySchedule);
+
+ Curve sizes are those of the objects themselves: Compiled curves also
+ allocate their programs, and logic curves point to children which
+ take up their own room.  A schedule's footprint counts its transition
+ list, but not the curves in it (which may be shared with others).
+
+*/
+#ifndef FOOTPRINT_H_
+#define FOOTPRINT_H_
+
+#include "VaRGBConfig.h"
+#include "VaRGBPlatform.h"
+#include "Schedule.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+#include <stdio.h>
+#endif
+
+namespace vargb {
+namespace Footprint {
+
+/*
+ * Entry
+ * The size, in bytes, of one type of object.
+ */
+typedef struct EntryStruct {
+	const char * name;
+	size_t bytes;
+} Entry;
+
+/*
+ * numCurveTypes/curveType
+ * The curve types enabled in VaRGBConfig.h, and the size of each.
+ */
+uint8_t numCurveTypes();
+Entry curveType(uint8_t idx);
+
+/*
+ * schedule
+ * Bytes used by the schedule and its transition list (see Schedule::footprint()).
+ */
+size_t schedule(const Schedule * sched);
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+/*
+ * print
+ * Writes the size of every curve type and of sched (if any) to out, one per line.
+ */
+void print(FILE * out, const Schedule * sched=NULL);
+#endif
+
+} /* namespace Footprint */
+} /* namespace vargb */
+
+#endif /* FOOTPRINT_H_ */
@@ -0,0 +1,151 @@
+/*
+
+ FramePipeline.h -- render/output frame handoff between threads, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ The FramePipeline is only available on VaRGB_TARGET_PLATFORM_POSIX hosts.
+
+ Pushing frames to the hardware (SPI, DMX, network...) can be slow, and
+ you don't want a sluggish bus write to hold up tick()ing the drivers.  A
+ FramePipeline lets one thread render frames while another outputs them,
+ without either ever waiting on the other.
+
+ It's a triple buffer: the render side always has a buffer to write into,
+ the output side always has a complete frame to read, and the third holds
+ the latest finished frame, swapped in or out with a single atomic
+ exchange.  There's exactly one rendering thread and one output thread.
+
+ Render thread, e.g. from a DriverGroup frame callback:
+
+   vargb::FramePipeline myPipeline(1000);
+
+   void myFrameCallback(const vargb::ColorSettings * frame,
+   			const uint8_t * dirty_bits, vargb::VaRGBFixtureIndex num_fixtures)
+   {
+     myPipeline.publish(frame);
+   }
+
+ (or fill renderBuffer() yourself and call publish()).
+
+ Output thread:
+
+   while (true) {
+     const vargb::ColorSettings * frame = myPipeline.latestFrame();
+     // ... push frame[0 .. numFixtures()-1] out to the lights
+   }
+
+ latestFrame() always returns the most recent complete frame.  If the
+ renderer got ahead, the frames it overwrote before they were output are
+ counted as droppedFrames(); if the output side asks before a new frame is
+ ready, it gets the previous one again and that's counted in lateFrames().
+
+*/
+#ifndef FRAMEPIPELINE_H_
+#define FRAMEPIPELINE_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include "VaRGBPlatform.h"
+#include "Curve.h"
+
+namespace vargb {
+
+class FramePipeline {
+public:
+	/*
+	 * FramePipeline constructor
+	 * Pass the number of fixtures in each frame.  Check valid() afterwards.
+	 */
+	FramePipeline(VaRGBFixtureIndex num_fixtures);
+
+	~FramePipeline();
+
+	bool valid() { return buffers != NULL;}
+
+	VaRGBFixtureIndex numFixtures() { return num_fixtures;}
+
+
+	/*
+	 * renderBuffer
+	 * Render side: where to write the next frame.  Valid until publish().
+	 */
+	ColorSettings * renderBuffer() { return frameBuffer(back_index);}
+
+	/*
+	 * publish
+	 * Render side: hand over the frame written to renderBuffer() (or copy
+	 * the frame passed) to the output side.  Never blocks.
+	 */
+	void publish();
+	void publish(const ColorSettings * frame);
+
+
+	/*
+	 * latestFrame
+	 * Output side: the most recent complete frame (all zeros until the first
+	 * publish()).  Valid until the next call.  Never blocks.
+	 */
+	const ColorSettings * latestFrame();
+
+	/*
+	 * frameNumber
+	 * Output side: the number of the frame last returned by latestFrame(),
+	 * counting from 1 (0 if nothing was published yet).
+	 */
+	uint32_t frameNumber() { return frame_numbers[front_index];}
+
+
+	/*
+	 * Counters, safe to read from either thread.
+	 * publishedFrames: frames handed over by the render side
+	 * droppedFrames: frames overwritten by a newer one before being output
+	 * lateFrames: calls to latestFrame() that found no new frame ready
+	 */
+	uint32_t publishedFrames() { return __atomic_load_n(&num_published, __ATOMIC_RELAXED);}
+	uint32_t droppedFrames() { return __atomic_load_n(&num_dropped, __ATOMIC_RELAXED);}
+	uint32_t lateFrames() { return __atomic_load_n(&num_late, __ATOMIC_RELAXED);}
+
+private:
+	VaRGBFixtureIndex num_fixtures;
+	ColorSettings * buffers;
+	uint32_t frame_numbers[3];
+
+	// the index of the buffer holding the latest finished frame, with the
+	// fresh bit set until the output side takes it.  Shared by both sides.
+	uint8_t middle_state;
+
+	uint8_t back_index; // render side's
+	uint8_t front_index; // output side's
+
+	uint32_t num_published;
+	uint32_t num_dropped;
+	uint32_t num_late;
+
+	ColorSettings * frameBuffer(uint8_t idx) { return &(buffers[idx * num_fixtures]);}
+
+};
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
+
+#endif /* FRAMEPIPELINE_H_ */
@@ -0,0 +1,235 @@
+/*
+
+ ParallelGroup.h -- drivers ticked by several threads, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ The ParallelGroup is only available on VaRGB_TARGET_PLATFORM_POSIX hosts,
+ and uses pthreads (link with -pthread).
+
+ With enough fixtures, a single thread tick()ing a DriverGroup runs out of
+ time before the next frame is due.  A ParallelGroup works just like a
+ DriverGroup with batched output, but spreads the work over a number of
+ threads:
+
+   vargb::ParallelGroup myGroup(20000, 4, myFrameCallback);
+   myGroup.add(&myFirstDriver);
+   // ...
+
+   while (true) {
+     myGroup.tickAndWait(&myClock);
+   }
+
+ Drivers are split, in the order they were added, into partitions of
+ VaRGB_PARALLELGROUP_PARTITION_SIZE, each its own DriverGroup writing into
+ its slice of a single frame buffer.  The partition size is such that every
+ slice of the frame and of the dirty bitset starts on a cache line of its
+ own, so threads never write to the same line.
+
+ Some drivers cost a lot more to tick than others (a deep logic curve over
+ a few sines, versus a Constant), so partitions can take wildly different
+ amounts of time.  Rather than sticking to a fixed share, the threads
+ balance the load by work-stealing: before each frame, the partitions are
+ dealt out in turn to each thread's deque.  Threads tick partitions from the
+ bottom of their own deque and, once it's empty, steal from the top of the
+ others', until there's nothing left anywhere.  A frame thus takes about as
+ long as its total work divided among the threads.  Smaller partitions (see
+ VaRGB_PARALLELGROUP_PARTITION_SIZE) make for finer balancing.
+
+ The threads are started with the group and live as long as it does.  On
+ every tick(), the calling thread (which counts as one of the threads, and
+ does its share) releases the others, all tick their partitions, and once
+ every last one is done the frame callback is invoked--from the calling
+ thread--with the complete frame, exactly as a single DriverGroup would
+ have produced it.
+
+ The drivers' schedules run on whichever thread ticks their partition, so
+ any schedule/transition callbacks they have must be safe to call from
+ another thread.  add(), reschedule() and sync() must only be called
+ from the thread that calls tick().
+
+*/
+#ifndef PARALLELGROUP_H_
+#define PARALLELGROUP_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <pthread.h>
+#include "DriverGroup.h"
+
+// size of the cache lines we keep threads from sharing
+#define VaRGB_CACHE_LINE_SIZE					64
+
+// drivers per partition: by default, its dirty bits fill exactly one
+// cache line and, whatever the size of ColorSettings, its frame slice a
+// whole number of them.  May be set smaller, for finer work-stealing at
+// the cost of some cache line sharing, but must remain a multiple of 8
+// (partitions can't share dirty bitset bytes).
+#ifndef VaRGB_PARALLELGROUP_PARTITION_SIZE
+#define VaRGB_PARALLELGROUP_PARTITION_SIZE		(VaRGB_CACHE_LINE_SIZE * 8)
+#endif
+
+namespace vargb {
+
+class ParallelGroup;
+
+/*
+ * ParallelGroupThread
+ * Each thread's state, on a cache line of its own, including its deque of
+ * partitions to tick this frame: tasks[top .. bottom-1].  The thread itself
+ * takes from the bottom, others steal from the top (a Chase-Lev deque, as
+ * only filled between frames).
+ */
+typedef struct ParallelGroupThreadStruct {
+	ParallelGroup * group;
+	pthread_t thread;
+	uint8_t index;
+	bool started;
+	VaRGBFixtureIndex num_touched;
+	uint16_t num_stolen;
+
+	uint16_t * tasks;
+	int32_t top;
+	int32_t bottom;
+} __attribute__((aligned(VaRGB_CACHE_LINE_SIZE))) ParallelGroupThread;
+
+
+class ParallelGroup {
+public:
+	/*
+	 * ParallelGroup constructor
+	 * Pass the maximum number of drivers the group will hold, the number of
+	 * threads to tick them with (including the one calling tick()) and the
+	 * end-of-frame callback.  Check valid() after construction, to ensure
+	 * all required memory and threads were available.
+	 */
+	ParallelGroup(VaRGBFixtureIndex max_drivers, uint8_t num_threads,
+			DriverGroup_Frame_Callback frame_cb);
+
+	~ParallelGroup();
+
+	bool valid() { return is_valid;}
+
+	/*
+	 * add
+	 * Adds a driver (which should already have its schedule) to the group.
+	 * Returns the driver's index within the group (and the frame), or
+	 * VaRGB_DRIVERGROUP_INVALID_INDEX if the group is full.
+	 */
+	VaRGBFixtureIndex add(VaRGB * driver);
+
+	VaRGBFixtureIndex numDrivers() { return num_drivers;}
+	VaRGB * driver(VaRGBFixtureIndex idx);
+
+	uint8_t numThreads() { return num_threads;}
+	uint16_t numPartitions() { return num_partitions;}
+
+	/*
+	 * frame/dirtyBits
+	 * The frame buffer and dirty bitset.
+	 */
+	const ColorSettings * frame() { return frame_buffer;}
+	const uint8_t * dirtyBits() { return dirty_bits;}
+
+	/*
+	 * reschedule/sync
+	 * As for DriverGroup.
+	 */
+	void reschedule(VaRGBFixtureIndex idx);
+	void sync();
+
+	/*
+	 * tick
+	 * Advance the group by num ticks, on all threads, then send the frame.
+	 */
+	void tick(VaRGBTimeValue num=1);
+
+	/*
+	 * tickAndDelay
+	 * Convenience function to tick() and delay VaRGB::tickDelayTimeMs() millis.
+	 */
+	void tickAndDelay(VaRGBTimeValue num=1);
+
+	/*
+	 * tickAndWait
+	 * Sleeps until the clock says the next tick is due, then tick()s by however
+	 * many ticks have elapsed (see VaRGB::tickAndWait).
+	 */
+	void tickAndWait(TickClock * clock);
+
+	/*
+	 * numTouched
+	 * How many drivers were tick()ed during the last tick, over all threads.
+	 */
+	VaRGBFixtureIndex numTouched();
+
+	/*
+	 * numStolen
+	 * How many partitions were stolen (ticked by another thread than the
+	 * one they were dealt to) during the last tick.
+	 */
+	uint16_t numStolen();
+
+private:
+	VaRGBFixtureIndex max_drivers;
+	VaRGBFixtureIndex num_drivers;
+	uint8_t num_threads;
+	uint16_t num_partitions;
+	bool is_valid;
+
+	DriverGroup_Frame_Callback frame_cb;
+	ColorSettings * frame_buffer;
+	uint8_t * dirty_bits;
+
+	// partition p is a DriverGroup at partitions + p * partition_stride
+	uint8_t * partitions;
+	size_t partition_stride;
+
+	// threads[0] is the one calling tick()
+	ParallelGroupThread * threads;
+	uint16_t * thread_tasks; // room for every thread's deque
+	pthread_barrier_t frame_start;
+	pthread_barrier_t frame_done;
+
+	// threads wait here until they've all been started (or not)
+	pthread_mutex_t launch_lock;
+	pthread_cond_t launch_cond;
+	bool launched;
+
+	// set before releasing the threads at frame_start
+	VaRGBTimeValue pending_ticks;
+	bool stopping;
+
+	DriverGroup * partition(uint16_t p) { return (DriverGroup*)(partitions + p * partition_stride);}
+	void launch();
+	void stopThreads();
+	void dealPartitions();
+	int16_t takePartition(ParallelGroupThread * thread);
+	int16_t stealPartition(ParallelGroupThread * victim);
+	void tickPartitions(ParallelGroupThread * thread);
+	static void * threadMain(void * thread_state);
+};
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
+
+#endif /* PARALLELGROUP_H_ */
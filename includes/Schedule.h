@@ -36,7 +36,8 @@
 
  Schedules maintain a list of pointers to Curves.  This list is
  dynamically expanded as required by the number of transitions you
- add.
+ add--or, if you know how many there will be, sized in one shot by
+ reserve() or by creating the schedule in an Arena (see Arena.h).
 
 */
 
@@ -46,6 +47,7 @@
 #include "VaRGBConfig.h"
 #include "VaRGBPlatform.h"
 #include "Curve.h"
+#include "Arena.h"
 
 #define VaRGB_SCHEDULE_CURVELIST_EXPAND_BYAMOUNT	5
 
@@ -67,6 +69,14 @@ public:
 	 */
 	Schedule(ScheduleID sched_id=0);
 
+	/*
+	 * Schedule constructor
+	 * Takes its transition list, with room for exactly max_transitions, from the
+	 * arena passed.  It never grows beyond that: addTransition() fails once
+	 * it's full.  Check valid() to ensure the arena had enough room.
+	 */
+	Schedule(Arena * arena, uint16_t max_transitions, ScheduleID sched_id=0);
+
 #ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
 	~Schedule();
 #endif
@@ -86,12 +96,85 @@ public:
 	 */
 	bool addTransition(vargb::Curve::Curve * curv);
 
+	/*
+	 * reserve
+	 * Makes room for num_transitions in all, in one go, rather than growing
+	 * the list a few at a time as transitions are added.
+	 */
+	bool reserve(uint16_t num_transitions);
+
+	bool valid() { return transition_ptr_list != NULL;}
+
+	/*
+	 * footprint
+	 * Bytes used by the schedule: the object itself and its transition list,
+	 * including any room reserved but not yet used.  The curves it points to
+	 * aren't counted (see Footprint.h).
+	 */
+	size_t footprint() const;
+
+	/*
+	 * setTick
+	 * Move to a given point in time, relative to the start of the schedule
+	 * (wrapping around if tick_count is beyond the end of the schedule).
+	 *
+	 * Finding the transition within which that tick falls is a binary search
+	 * over the start tick of each transition, so seeking in long schedules stays
+	 * cheap.
+	 */
 	void setTick(VaRGBTimeValue tick_count);
 
-	void tick(uint8_t num=1);
+	/*
+	 * valueAt
+	 * Returns the illumination settings the schedule would be at, tick_count
+	 * ticks after its start (wrapping around, like setTick()).  Has no side
+	 * effects on the schedule or its curves.
+	 */
+	IlluminationSettings valueAt(VaRGBTimeValue tick_count) const;
+
+	/*
+	 * totalTicks
+	 * The length of one run through all the transitions, in ticks.
+	 */
+	VaRGBTimeValue totalTicks() const { return total_schedule_ticks;}
+
+	/*
+	 * tick
+	 * Advance the schedule by num ticks.  Ticks left over when the current
+	 * transition completes spill over into the next one, so a single call
+	 * ends up where num calls to tick(1) would have--at a cost that depends
+	 * on the number of transitions crossed, not on num.
+	 *
+	 * Stops early when the last transition completes: runCompleted() then
+	 * returns true and the number of ticks not yet used is returned, so the
+	 * driver can notify its schedule-completed callback before going on.
+	 * Nothing more is sent until the schedule is restarted with setTick().
+	 */
+	VaRGBTimeValue tick(VaRGBTimeValue num=1);
+
+	/*
+	 * ticksUntilNextChange
+	 * The number of ticks before the current transition might next change the
+	 * colors or complete (see Curve::ticksUntilNextChange()).
+	 */
+	VaRGBTimeValue ticksUntilNextChange();
+
+	/*
+	 * runCompleted
+	 * True if the last tick() reached the end of the schedule (and it
+	 * hasn't been setTick() since).
+	 */
+	bool runCompleted() { return run_completed;}
 
 	void setDriver(VaRGB* drv) { driver = drv;}
 
+	/*
+	 * sendCurTransitionSettings
+	 * Pass the current transition's settings on to the driver, whether or not
+	 * they've changed.
+	 */
+	void sendCurTransitionSettings();
+
 	/*
 	 * id
 	 * Returns the ID for this schedule.
@@ -103,17 +186,21 @@ private:
 
 	ScheduleID sched_id;
 	vargb::Curve::Curve ** transition_ptr_list;
-	uint8_t transition_index; // current index
-	uint8_t transition_num; // number in list
-	uint8_t transition_max; // max space in list
-	uint16_t total_schedule_ticks;
+	VaRGBTimeValue * transition_start_ticks; // tick at which each transition begins
+	uint16_t transition_index; // current index
+	uint16_t transition_num; // number in list
+	uint16_t transition_max; // max space in list
+	VaRGBTimeValue total_schedule_ticks;
+	bool run_completed;
+	bool fixed_list; // list comes from an arena: never grown or freed
 
 	VaRGB * driver;
 
 
-	bool expandTransitionList(uint8_t byamount=VaRGB_SCHEDULE_CURVELIST_EXPAND_BYAMOUNT);
+	bool expandTransitionList(uint16_t byamount=VaRGB_SCHEDULE_CURVELIST_EXPAND_BYAMOUNT);
+
+	uint16_t transitionIndexAt(VaRGBTimeValue tick_position) const;
 
-	void sendCurTransitionSettings();
 
 
 
@@ -0,0 +1,122 @@
+/*
+
+ ScheduleCursor.h -- per-fixture playback of shared schedules, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ A Schedule and its curves keep their playback state (tick counts, current
+ settings, flags) right alongside their definition (targets, periods,
+ number of flashes...).  So a schedule driven by a VaRGB driver can't
+ also be used by another one, and a thousand fixtures running the same
+ show need a thousand copies of the whole curve tree.
+
+ A ScheduleCursor is the playback state alone: which schedule, how far
+ along, and the colors last reported--a handful of bytes.  It never
+ touches the schedule's (or its curves') own state, relying only on the
+ side-effect free Schedule::valueAt(), so any number of cursors may share
+ one schedule definition:
+
+   vargb::Schedule myShow;
+   // ... add all the transitions ...
+
+   vargb::ScheduleCursor cursors[1000];
+   for (uint16_t i=0; i < 1000; i++)
+   {
+     cursors[i].setSchedule(&myShow, i * 5); // each a little further along
+   }
+
+   // then, on every tick:
+   for (uint16_t i=0; i < 1000; i++)
+   {
+     if (cursors[i].tick())
+     {
+       setFixtureColor(i, cursors[i].currentSettings());
+     }
+   }
+
+ Cursors simply loop through the schedule--check runCompleted() after a
+ tick() to find out when they've wrapped around.  A schedule shared this
+ way shouldn't be changed (e.g. have transitions added) while cursors are
+ using it.
+
+*/
+
+#ifndef SCHEDULECURSOR_H_
+#define SCHEDULECURSOR_H_
+
+#include "VaRGBConfig.h"
+#include "VaRGBPlatform.h"
+#include "Schedule.h"
+
+namespace vargb {
+
+class ScheduleCursor {
+public:
+	/*
+	 * ScheduleCursor constructor
+	 * Optionally pass the (shared) schedule to follow, and how many ticks
+	 * into it to start.
+	 */
+	ScheduleCursor(const Schedule * sched=NULL, VaRGBTimeValue start_tick=0);
+
+	/*
+	 * setSchedule
+	 * Start following sched, start_tick ticks in.
+	 */
+	void setSchedule(const Schedule * sched, VaRGBTimeValue start_tick=0);
+
+	const Schedule * schedule() { return cur_schedule;}
+
+	/*
+	 * tick
+	 * Advance num ticks along the schedule (looping around at its end).
+	 * Returns true if the colors changed, false otherwise.
+	 */
+	bool tick(VaRGBTimeValue num=1);
+
+	/*
+	 * position
+	 * Current number of ticks into the schedule.
+	 */
+	VaRGBTimeValue position() { return tick_position;}
+
+	/*
+	 * runCompleted
+	 * True if the last tick() went past the end of the schedule.
+	 */
+	bool runCompleted() { return run_completed;}
+
+	/*
+	 * currentSettings
+	 * The colors at the current position.
+	 */
+	ColorSettings * currentSettings() { return &current_settings;}
+
+private:
+	const Schedule * cur_schedule;
+	VaRGBTimeValue tick_position;
+	ColorSettings current_settings;
+	bool run_completed;
+
+	bool update();
+};
+
+} /* namespace vargb */
+
+#endif /* SCHEDULECURSOR_H_ */
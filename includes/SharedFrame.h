@@ -0,0 +1,187 @@
+/*
+
+ SharedFrame.h -- frame publication through shared memory, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ Shared frames are only available on VaRGB_TARGET_PLATFORM_POSIX hosts (link
+ with -lrt on older glibc).
+
+ When several processes need the live colors--the hardware writer, a
+ monitoring UI, a recorder--a SharedFrameWriter publishes each frame into a
+ named shared memory region, and any number of SharedFrameReaders map that
+ region to read it.  No sockets, no copies through the kernel.
+
+ Access is guarded by a sequence lock: the writer bumps a counter before and
+ after updating the frame, and readers retry if the counter changed (or was
+ odd) while they were reading.  The writer never waits for anyone, so a slow
+ or stuck reader can't hold up the tick loop.
+
+ Publishing, e.g. from a DriverGroup frame callback:
+
+   vargb::SharedFrameWriter myShared("/myshow", 1000);
+
+   void myFrameCallback(const vargb::ColorSettings * frame,
+   			const uint8_t * dirty_bits, vargb::VaRGBFixtureIndex num_fixtures)
+   {
+     myShared.publish(frame, dirty_bits); // only copies what changed
+   }
+
+ Reading, in some other process:
+
+   vargb::SharedFrameReader reader;
+   if (reader.open("/myshow"))
+   {
+     vargb::ColorSettings * colors = new vargb::ColorSettings[reader.numFixtures()];
+     reader.snapshot(colors);
+   }
+
+ or, to read in place without copying anything:
+
+   uint32_t token;
+   do {
+     token = reader.beginRead();
+     // ... look at reader.frame()[i]
+   } while (! reader.endRead(token));
+
+*/
+#ifndef SHAREDFRAME_H_
+#define SHAREDFRAME_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <stddef.h>
+#include "VaRGBPlatform.h"
+#include "Curve.h"
+
+#define VaRGB_SHAREDFRAME_MAGIC			"VaRGBfrm"
+#define VaRGB_SHAREDFRAME_VERSION			1
+
+namespace vargb {
+
+/*
+ * SharedFrameHeader
+ * What's found at the start of the shared region, followed by
+ * num_fixtures ColorSettings.
+ */
+typedef struct SharedFrameHeaderStruct {
+	char magic[8];
+	uint16_t version;
+	uint16_t header_size;
+	uint32_t num_fixtures;
+	uint32_t sequence; // odd while the frame is being updated
+	uint32_t frame_number;
+} SharedFrameHeader;
+
+
+class SharedFrameWriter {
+public:
+	/*
+	 * SharedFrameWriter constructor
+	 * Creates (or re-uses) the shared memory region called name (e.g. "/myshow")
+	 * for frames of num_fixtures.  Check valid() afterwards.
+	 */
+	SharedFrameWriter(const char * name, VaRGBFixtureIndex num_fixtures);
+
+	~SharedFrameWriter();
+
+	bool valid() { return header != NULL;}
+
+	/*
+	 * publish
+	 * Copy the frame into shared memory.  If dirty_bits are passed (as given
+	 * to a DriverGroup frame callback), only the fixtures flagged are copied.
+	 */
+	void publish(const ColorSettings * frame, const uint8_t * dirty_bits=NULL);
+
+	uint32_t frameNumber() { return header->frame_number;}
+
+	/*
+	 * close
+	 * Unmaps the region.  It stays around for readers until remove()d.
+	 */
+	void close();
+
+	/*
+	 * remove
+	 * Deletes the named region (readers that have it mapped keep their copy).
+	 */
+	static bool remove(const char * name);
+
+private:
+	SharedFrameHeader * header;
+	ColorSettings * colors;
+	size_t region_len;
+};
+
+
+class SharedFrameReader {
+public:
+	SharedFrameReader();
+	~SharedFrameReader();
+
+	/*
+	 * open
+	 * Maps the named region, read-only.  Returns false if it doesn't exist
+	 * or wasn't created by a SharedFrameWriter.
+	 */
+	bool open(const char * name);
+	void close();
+
+	bool valid() { return header != NULL;}
+
+	VaRGBFixtureIndex numFixtures() { return header->num_fixtures;}
+
+	/*
+	 * beginRead/endRead
+	 * For reading frame() in place: beginRead() returns a token to pass to
+	 * endRead() once you're done, which returns false if the writer changed
+	 * the frame in the meantime--in which case, start over.
+	 */
+	uint32_t beginRead();
+	bool endRead(uint32_t token);
+	const volatile ColorSettings * frame() { return colors;}
+
+	/*
+	 * snapshot
+	 * Copies a consistent frame into the numFixtures() ColorSettings passed,
+	 * and returns its frame number.
+	 */
+	uint32_t snapshot(ColorSettings * into);
+
+	/*
+	 * frameNumber
+	 * The number of the last frame published, e.g. to check for a new one
+	 * before bothering with a snapshot().
+	 */
+	uint32_t frameNumber();
+
+private:
+	const SharedFrameHeader * header;
+	const volatile ColorSettings * colors;
+	size_t region_len;
+};
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
+
+#endif /* SHAREDFRAME_H_ */
@@ -0,0 +1,113 @@
+/*
+
+ TickClock.h -- part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+
+ *****************************  OVERVIEW  *****************************
+
+ The TickClock is only available on VaRGB_TARGET_PLATFORM_POSIX hosts.
+
+ On a microcontroller, the main loop can get away with delay()ing for
+ tickDelayTimeMs(), minus whatever time it spent doing other things (see
+ the MultiDriver example).  On a busy host, that approach drifts: the process
+ gets scheduled late, sleeps overshoot and the lights slowly fall behind.
+
+ A TickClock keeps time using the monotonic clock, relative to the moment it
+ was started.  Tick N is due exactly at start + N * tickDelayTimeMs(), and
+ waitForTicks() sleeps until the next tick is due (without spinning) and
+ returns the number of ticks that have elapsed since the last call--normally
+ 1, more if the process was held up.  Hand that number to VaRGB::tick() and
+ the driver stays in step with the wall clock, no matter the load:
+
+	vargb::TickClock clock;
+
+	while (true) {
+		myDriver.tick(clock.waitForTicks());
+	}
+
+ or, equivalently, myDriver.tickAndWait(&clock) in the loop.
+
+*/
+
+#ifndef TICKCLOCK_H_
+#define TICKCLOCK_H_
+
+#include "VaRGBConfig.h"
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+
+#include <inttypes.h>
+#include <time.h>
+#include "VaRGBPlatform.h"
+
+namespace vargb {
+
+class TickClock {
+public:
+	/*
+	 * TickClock constructor
+	 * Optionally pass the number of milliseconds per tick (defaults to
+	 * VaRGB_DELAY_BETWEEN_UPDATES_MS).  The clock starts counting right away.
+	 */
+	TickClock(uint32_t ms_per_tick=VaRGB_DELAY_BETWEEN_UPDATES_MS);
+
+	/*
+	 * reset
+	 * Restart the clock: now becomes tick 0.
+	 */
+	void reset();
+
+	/*
+	 * elapsedTicks
+	 * Returns the number of ticks that have elapsed since the last
+	 * waitForTicks()/elapsedTicks() call, without sleeping, and marks them
+	 * as delivered.
+	 */
+	VaRGBTickCount elapsedTicks();
+
+	/*
+	 * waitForTicks
+	 * Sleeps until the next tick is due--or, if min_ticks is specified, until
+	 * that many ticks have elapsed--returning immediately if we're already
+	 * late, and returns the number of ticks elapsed since last called (always
+	 * at least min_ticks).
+	 */
+	VaRGBTickCount waitForTicks(VaRGBTickCount min_ticks=1);
+
+	/*
+	 * ticksDelivered
+	 * Total number of ticks handed out since the clock was (re)started.
+	 */
+	uint64_t ticksDelivered() { return ticks_delivered; }
+
+private:
+	uint64_t ns_per_tick;
+	uint64_t start_ns;
+	uint64_t ticks_delivered;
+
+	static uint64_t nowNs();
+	uint64_t ticksSinceStart();
+
+};
+
+} /* namespace vargb */
+
+#endif /* VaRGB_TARGET_PLATFORM_POSIX */
+
+#endif /* TICKCLOCK_H_ */
@@ -0,0 +1,272 @@
+/*
+
+ VaRGBArray.h -- multi-fixture VaRGB driver, part of the VaRGB library.
+ Copyright (C) 2013 Pat Deegan.
+
+ http://www.flyingcarsandstuff.com/projects/vargb/
+
+ Created on: 2026-10-17
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See file LICENSE.txt for further informations on licensing terms.
+
+ *****************************  OVERVIEW  *****************************
+
+ The VaRGB driver, along with its Schedule and Curves, is great for
+ handling a few RGB lights.  When you need to drive hundreds or thousands
+ of fixtures, having one driver, one schedule and a bunch of curve objects
+ per fixture gets expensive: every tick() walks through each of them, one
+ (virtual) call at a time.
+
+ The VaRGBArray driver handles any number of fixtures in a single object.
+ Rather than keeping an object per curve, it keeps the state of every
+ fixture's current curve in plain arrays--one array per attribute--with
+ all the fixtures running the same type of curve packed together.  On each
+ tick(), it runs through each curve type's list of fixtures in one tight loop.
+
+ Each fixture behaves exactly as it would if driven by its own Constant,
+ Linear, Flasher or Sine curve.  In essence:
+
+ * create callback(s), for setting the color of a fixture and optionally to
+   be notified when a fixture's curve has completed:
+
+   void myFixtureColorCallback(vargb::VaRGBFixtureIndex fixture,
+   			vargb::ColorSettings * set_to)
+   {
+     // ... set the color of light number 'fixture'
+   }
+
+   void myFixtureDoneCallback(vargb::VaRGBFixtureIndex fixture)
+   {
+     // ... maybe set the next curve for this fixture, e.g.
+     myArray.setLinear(fixture, 0, 0, 0, 2);
+   }
+
+ * create the driver, specifying the number of fixtures:
+
+   vargb::VaRGBArray myArray(1000, myFixtureColorCallback, myFixtureDoneCallback);
+
+ * assign curves to the fixtures:
+
+   for (vargb::VaRGBFixtureIndex i=0; i < 1000; i++)
+   {
+     myArray.setSine(i, 1023, 500, 0, 60, 2, (i * 10) % 360);
+   }
+
+ * and tick() the array, just like you would a VaRGB driver.
+
+ When a fixture's curve completes, the curve-completed callback is invoked
+ with the fixture's index.  If the callback doesn't set a new curve for that
+ fixture (or there is no such callback), the fixture simply holds its last
+ color until you give it something else to do.
+
+*/
+#ifndef VARGBARRAY_H_
+#define VARGBARRAY_H_
+
+#include "VaRGBConfig.h"
+#include "VaRGBPlatform.h"
+#include "Curve.h"
+
+#define VaRGB_ARRAY_MAX_POOL_COLUMNS		16
+
+namespace vargb {
+
+/*
+ * Signature for the fixture set-color callback.  The function must have the form:
+ *
+ * void myfunctionname(vargb::VaRGBFixtureIndex fixture, vargb::ColorSettings * set_colors_to);
+ */
+typedef void (*VaRGBArray_SetColor_Callback)(VaRGBFixtureIndex fixture, ColorSettings * set_colors_to);
+
+/*
+ * Signature for the fixture curve-completed callback.  The function must have the form:
+ *
+ * void mycurvecompletedcb(vargb::VaRGBFixtureIndex fixture);
+ */
+typedef void (*VaRGBArray_Curve_Completed)(VaRGBFixtureIndex fixture);
+
+
+/*
+ * ArrayCurveType
+ * The types of curves a VaRGBArray fixture may be running.
+ */
+typedef enum ArrayCurveTypeEnum {
+	ArrayCurveNone=0,
+	ArrayCurveConstant,
+	ArrayCurveLinear,
+	ArrayCurveFlasher,
+	ArrayCurveSine,
+	ArrayCurveNumTypes
+} ArrayCurveType;
+
+
+/*
+ * ArrayPool
+ * Used internally: the state of all fixtures running a given type of curve,
+ * as a set of "columns" (arrays) with one entry per fixture.
+ */
+typedef struct ArrayPoolStruct {
+	void * columns[VaRGB_ARRAY_MAX_POOL_COLUMNS];
+	uint8_t column_sizes[VaRGB_ARRAY_MAX_POOL_COLUMNS];
+	uint8_t num_columns;
+	VaRGBFixtureIndex count;
+	void * storage;
+} ArrayPool;
+
+
+class VaRGBArray {
+public:
+	/*
+	 * VaRGBArray constructor.
+	 * Pass the number of fixtures to handle, the fixture color-setting callback
+	 * and, optionally, a curve-completed callback.
+	 *
+	 * Check valid() after construction, to ensure all required memory was
+	 * available.
+	 */
+	VaRGBArray(VaRGBFixtureIndex num_fixtures, VaRGBArray_SetColor_Callback set_color_with_cb,
+			VaRGBArray_Curve_Completed curve_comp_cb=NULL);
+
+#ifdef VaRGB_CLASS_DESTRUCTORS_ENABLE
+	~VaRGBArray();
+#endif
+
+	/*
+	 * valid
+	 * Returns true if the driver managed to allocate everything it needs.
+	 */
+	bool valid() { return fixture_type != NULL; }
+
+	/*
+	 * numFixtures
+	 * Returns the number of fixtures handled.
+	 */
+	VaRGBFixtureIndex numFixtures() { return num_fixtures; }
+
+#if VaRGB_DELAY_BETWEEN_UPDATES_MS > 255
+	inline static uint16_t tickDelayTimeMs() { return VaRGB_DELAY_BETWEEN_UPDATES_MS;}
+#else
+	inline static uint8_t tickDelayTimeMs() { return VaRGB_DELAY_BETWEEN_UPDATES_MS; }
+#endif
+
+	inline void setColorSetCallback(VaRGBArray_SetColor_Callback cb) { set_color_cb = cb;}
+	inline void setCurveCompletedCallback(VaRGBArray_Curve_Completed cb) { curve_completed_cb = cb;}
+
+	/*
+	 * setConstant/setLinear/setFlasher/setSine
+	 * Start a new curve on the fixture, replacing whatever it was doing.  The
+	 * parameters are those of the corresponding vargb::Curve constructor.
+	 *
+	 * Linear curves start from the fixture's current color unless you pass
+	 * other initial_settings.
+	 *
+	 * Each returns false if the fixture index is out of range, or the memory
+	 * for this type of curve couldn't be allocated.
+	 */
+	bool setConstant(VaRGBFixtureIndex fixture, VaRGBColorValue target_red, VaRGBColorValue target_green,
+			VaRGBColorValue target_blue, VaRGBTimeValue trans_time_seconds);
+
+#ifdef VaRGB_ENABLE_CURVE_LINEAR
+	bool setLinear(VaRGBFixtureIndex fixture, VaRGBColorValue target_red, VaRGBColorValue target_green,
+			VaRGBColorValue target_blue, VaRGBTimeValue trans_time_seconds,
+			IlluminationSettings* initial_settings=NULL);
+#endif
+
+#ifdef VaRGB_ENABLE_CURVE_FLASHER
+	bool setFlasher(VaRGBFixtureIndex fixture, VaRGBColorValue target_red, VaRGBColorValue target_green,
+			VaRGBColorValue target_blue, VaRGBTimeValue time_seconds,
+			uint8_t numFlashes, IlluminationSettings* base_settings=NULL);
+#endif
+
+#ifdef VaRGB_ENABLE_CURVE_SINE
+	bool setSine(VaRGBFixtureIndex fixture, VaRGBColorValue target_red, VaRGBColorValue target_green,
+			VaRGBColorValue target_blue, VaRGBTimeValue time_seconds,
+			uint8_t seconds_per_cycle, uint16_t phase_degrees=0);
+#endif
+
+	/*
+	 * stop
+	 * Stop whatever curve the fixture is running.  It will keep its current color.
+	 */
+	void stop(VaRGBFixtureIndex fixture);
+
+	/*
+	 * curveType
+	 * The type of curve currently running on the fixture (ArrayCurveNone if idle).
+	 */
+	ArrayCurveType curveType(VaRGBFixtureIndex fixture) { return (ArrayCurveType)fixture_type[fixture]; }
+
+	/*
+	 * currentSettings
+	 * Fills the ColorSettings passed with the fixture's current color.
+	 */
+	void currentSettings(VaRGBFixtureIndex fixture, ColorSettings * into);
+
+	/*
+	 * tick
+	 * Inform every fixture's curve of the passage of time.  Do this every
+	 * VaRGBArray::tickDelayTimeMs() milliseconds.
+	 */
+	void tick(VaRGBTimeValue num=1);
+
+	/*
+	 * tickAndDelay
+	 * Convenience function to tick() and delay tickDelayTimeMs() millis.
+	 */
+	void tickAndDelay(VaRGBTimeValue num=1);
+
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+	/*
+	 * tickAndWait
+	 * Sleeps until the clock says the next tick is due, then tick()s by however
+	 * many ticks have elapsed (see VaRGB::tickAndWait).
+	 */
+	void tickAndWait(TickClock * clock);
+#endif
+
+private:
+	VaRGBArray_SetColor_Callback set_color_cb;
+	VaRGBArray_Curve_Completed curve_completed_cb;
+	VaRGBFixtureIndex num_fixtures;
+
+	// per-fixture state
+	uint8_t * fixture_type;
+	uint8_t * fixture_flags;
+	VaRGBFixtureIndex * fixture_slot;
+	VaRGBColorValue * fixture_values[VaRGB_NUM_COLORS];
+
+	// fixtures needing an update/having completed during this tick
+	VaRGBFixtureIndex * dirty_list;
+	VaRGBFixtureIndex num_dirty;
+	VaRGBFixtureIndex * completed_list;
+	VaRGBFixtureIndex num_completed;
+
+	ArrayPool pools[ArrayCurveNumTypes];
+
+
+	bool allocatePool(ArrayCurveType type);
+	bool prepareSlot(VaRGBFixtureIndex fixture, ArrayCurveType type, VaRGBTimeValue trans_ticks);
+	void releaseSlot(VaRGBFixtureIndex fixture);
+
+	void markDirty(VaRGBFixtureIndex fixture);
+	void markCompleted(VaRGBFixtureIndex fixture);
+
+	void tickConstants(VaRGBTimeValue num);
+	void tickLinears(VaRGBTimeValue num);
+	void tickFlashers(VaRGBTimeValue num);
+	void tickSines(VaRGBTimeValue num);
+
+};
+
+} /* end namespace vargb */
+
+#endif /* VARGBARRAY_H_ */
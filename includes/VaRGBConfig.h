@@ -64,7 +64,8 @@
  *
  *  Enabled by default when you define
  *  VaRGB_ENABLE_CURVE_LOGICAL:
- *   AND, OR, NOT, Shift and Threshold
+ *   AND, OR, NOT, Shift and Threshold, as well as the
+ *   Compiled curve (flattened logic trees)
  *
  *
  */
@@ -91,9 +92,78 @@
 #define VaRGB_ENABLE_CURVE_NOTLOGIC
 #define VaRGB_ENABLE_CURVE_SHIFTLOGIC
 #define VaRGB_ENABLE_CURVE_THRESHOLDLOGIC
+#define VaRGB_ENABLE_CURVE_COMPILEDLOGIC
+
+// most children a single logic curve (e.g. an n-ary AndLogic) may
+// combine.  Each logic curve holds room for this many child pointers.
+#define VaRGB_CURVE_LOGIC_MAXCHILDREN		4
+#endif
+
+
+
+/*
+ * VaRGB_LINEAR_DDA
+ *
+ * When defined, Linear curves step along using a (Bresenham-style)
+ * fixed-point accumulator: each tick adds the whole part of the per-tick
+ * change plus a fraction, carrying over an extra unit whenever the fraction
+ * adds up.  Setup is a single division per color, and the target is always
+ * hit exactly, right at the end of the transition.
+ *
+ * On by default.  Build with -DVaRGB_NO_LINEAR_DDA to go back to the
+ * original "increment every N ticks" search (whose colors differ slightly
+ * from the DDA's, and may stop a few units short on very long fades).
+ */
+#ifndef VaRGB_NO_LINEAR_DDA
+#define VaRGB_LINEAR_DDA
+#endif
+
+
+/*
+ * VaRGB_SINE_LUT
+ *
+ * When defined, Sine curves avoid floating point entirely: the phase is
+ * computed in integer fractions of a cycle from the tick count, looked up
+ * in a quarter-wave table (about 0.5k of flash) and applied to the targets
+ * in fixed point.  Much cheaper than calling sin() on MCUs without an FPU,
+ * or when running lots of sines.
+ *
+ * On by default.  Build with -DVaRGB_NO_SINE_LUT to use libm's sin()
+ * instead (colors may then differ by a unit or so from the table's).
+ */
+#ifndef VaRGB_NO_SINE_LUT
+#define VaRGB_SINE_LUT
 #endif
 
 
+/*
+ * VaRGB_ENABLE_SCHEDULE_BAKING
+ *
+ * Define to be able to "bake" a Schedule into a table of
+ * pre-computed frames (one per tick), played back by a
+ * BakedSchedule at the cost of a table lookup per tick.
+ * Frame tables use 4 bytes per tick (for 10-bit colors),
+ * so on small MCUs keep them short.
+ */
+#define VaRGB_ENABLE_SCHEDULE_BAKING
+
+
+
+/*
+ * VaRGB_COMPACT_LAYOUT
+ *
+ * Define when running huge numbers of fixtures, to squeeze each curve
+ * into as little memory as possible (so more of them fit in cache):
+ * color values are stored in 16 bits, rather than a full int, on the
+ * generic driver platform, linear increments likewise, and the curves'
+ * flags are packed into bits.
+ *
+ * Color values must then fit in 16 bits (VaRGB_GENERIC_PLAT_COLORVALUE_MAX,
+ * below).  See Footprint.h to check what each curve and schedule costs.
+ */
+// #define VaRGB_COMPACT_LAYOUT
+
+
 
 
 /*
@@ -142,7 +212,11 @@
  *
  */
 #ifdef VaRGB_DRIVER_PLATFORM_GENERIC
+#ifdef VaRGB_COMPACT_LAYOUT
+#define VaRGB_GENERIC_PLAT_COLORVALUE_TYPE		uint16_t
+#else
 #define VaRGB_GENERIC_PLAT_COLORVALUE_TYPE		unsigned int
+#endif
 #define VaRGB_GENERIC_PLAT_COLORVALUE_MAX		1023
 #endif
 
@@ -170,6 +244,29 @@
 
 
 
+/*
+ * VaRGB_TIMEVALUE_BITS
+ *
+ * The width of VaRGBTimeValue, used for all tick counts and durations:
+ * curve transition times, schedule lengths and positions, and the
+ * drivers' tick counts.
+ *
+ * 16 bits keep things small, but at 50 ticks per second a schedule can
+ * only last about 21 minutes (and a driver's tickCount() wraps around
+ * that often).  Use 32 (over 2 years) for long running shows--e.g. a
+ * whole day's installation as a single schedule--or 64 if you must.
+ * May also be set from the build (e.g. -DVaRGB_TIMEVALUE_BITS=32).
+ */
+#ifndef VaRGB_TIMEVALUE_BITS
+#define VaRGB_TIMEVALUE_BITS					16
+#endif
+
+#if VaRGB_TIMEVALUE_BITS != 16 && VaRGB_TIMEVALUE_BITS != 32 && VaRGB_TIMEVALUE_BITS != 64
+#error "VaRGB_TIMEVALUE_BITS must be 16, 32 or 64 (see config)"
+#endif
+
+
+
 /*
  * VaRGB_CLASS_DESTRUCTORS_ENABLE
  *
@@ -184,6 +281,19 @@
 
 
 
+/*
+ * VaRGB_ALLOCATION_AUDIT
+ *
+ * All the library's heap allocations go through the VaRGB_MALLOC() and
+ * friends (see VaRGBPlatform.h).  When this is defined, these count every
+ * allocation, so you can check that nothing is allocated once you're done
+ * setting up (see vargb::allocationAuditMark()).  Costs a little time on
+ * each allocation, so it's disabled by default.
+ */
+//#define VaRGB_ALLOCATION_AUDIT
+
+
+
 
 /*
  * VaRGB_TARGET_PLATFORM_XXX
@@ -196,9 +306,18 @@
  * VaRGB_TARGET_PLATFORM_ARDUINO
  * For Arduinos.
  *
- * And that's it for now.
+ * VaRGB_TARGET_PLATFORM_POSIX
+ * For Linux (and other POSIX) hosts, e.g. the Raspberry Pi.  Uses the
+ * monotonic clock for delays and provides the TickClock (see TickClock.h)
+ * to keep ticks in step with real time.
+ *
+ * Arduino is the default, unless VaRGB_TARGET_PLATFORM_POSIX has been
+ * defined already (e.g. on the compiler command line, with
+ * -DVaRGB_TARGET_PLATFORM_POSIX).
  */
+#ifndef VaRGB_TARGET_PLATFORM_POSIX
 #define VaRGB_TARGET_PLATFORM_ARDUINO
+#endif
 
 
 
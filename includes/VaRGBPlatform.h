@@ -33,19 +33,68 @@
 #define VARGBPLATFORM_H_
 
 #include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "VaRGBConfig.h"
 
 #define VaRGB_MAXIMUM_UPDATE_DELAY_SECONDS		11
 
 namespace vargb {
 
 
+/*
+ * VaRGBTimeValue -- a number of ticks (see VaRGB_TIMEVALUE_BITS)
+ * VaRGBTimeProduct -- room for the product of a VaRGBTimeValue and a
+ * 			color value (or a second VaRGBTimeValue, below 64 bits), when
+ * 			scaling by time
+ * VaRGBTickCount -- a running count of ticks, e.g. from a TickClock
+ */
+#if VaRGB_TIMEVALUE_BITS == 64
+typedef uint64_t VaRGBTimeValue;
+typedef uint64_t VaRGBTimeProduct;
+typedef uint64_t VaRGBTickCount;
+#elif VaRGB_TIMEVALUE_BITS == 32
+typedef uint32_t VaRGBTimeValue;
+typedef uint64_t VaRGBTimeProduct;
+typedef uint32_t VaRGBTickCount;
+#else
 typedef uint16_t VaRGBTimeValue;
+typedef uint32_t VaRGBTimeProduct;
+typedef uint32_t VaRGBTickCount;
+#endif
+
+// largest possible VaRGBTimeValue
+#define VaRGB_TIMEVALUE_MAX		((vargb::VaRGBTimeValue)-1)
+
+// index of a fixture (RGB light) within multi-fixture drivers, like VaRGBArray
+typedef uint16_t VaRGBFixtureIndex;
 
 
 // hides VaRGB_TARGET_PLATFORM_* specific details of the delay method
 void delayMs(unsigned long ms);
 
 
+#ifdef VaRGB_ALLOCATION_AUDIT
+/*
+ * Allocation audit
+ * Every heap allocation made through VaRGB_MALLOC(), VaRGB_CALLOC(),
+ * VaRGB_REALLOC() or VaRGB_MEMALIGN() is counted.  Call allocationAuditMark()
+ * once everything's set up, then allocationsSinceMark() tells you how
+ * many allocations were made since--which should be 0.
+ */
+void * auditedMalloc(size_t size);
+void * auditedCalloc(size_t num, size_t size);
+void * auditedRealloc(void * ptr, size_t size);
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+int auditedMemalign(void ** ptr, size_t alignment, size_t size);
+#endif
+
+void allocationAuditMark();
+uint32_t allocationsSinceMark();
+uint32_t allocationCount();
+#endif
+
+
 
 } /* end namespace vargb */
 
@@ -63,6 +112,41 @@ void delayMs(unsigned long ms);
 #include <Arduino.h>
 #endif
 
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+#include <time.h>
+#include "TickClock.h"
+#endif
+
+// constant lookup tables live in flash, where we have that option
+#ifdef VaRGB_TARGET_PLATFORM_ARDUINO
+#define VaRGB_PROGMEM						PROGMEM
+#define VaRGB_READ_TABLE_WORD(addr)			pgm_read_word(addr)
+#else
+#define VaRGB_PROGMEM
+#define VaRGB_READ_TABLE_WORD(addr)			(*(addr))
+#endif
+
+// heap allocations, see VaRGB_ALLOCATION_AUDIT
+#ifdef VaRGB_ALLOCATION_AUDIT
+#define VaRGB_MALLOC(size)					vargb::auditedMalloc(size)
+#define VaRGB_CALLOC(num, size)				vargb::auditedCalloc((num), (size))
+#define VaRGB_REALLOC(ptr, size)			vargb::auditedRealloc((ptr), (size))
+#define VaRGB_MEMALIGN(ptr, align, size)	vargb::auditedMemalign((ptr), (align), (size))
+#else
+#define VaRGB_MALLOC(size)					malloc(size)
+#define VaRGB_CALLOC(num, size)				calloc((num), (size))
+#define VaRGB_REALLOC(ptr, size)			realloc((ptr), (size))
+#define VaRGB_MEMALIGN(ptr, align, size)	posix_memalign((ptr), (align), (size))
+#endif
+#define VaRGB_FREE(ptr)						free(ptr)
+
+// bookkeeping that must be kept per-thread, where we have threads
+#ifdef VaRGB_TARGET_PLATFORM_POSIX
+#define VaRGB_THREAD_LOCAL					__thread
+#else
+#define VaRGB_THREAD_LOCAL
+#endif
+
 
 #ifndef NULL
 #define NULL 	0x0